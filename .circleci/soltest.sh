@@ -12,6 +12,7 @@
 #     EVM=version_string      Specifies EVM version to compile for (such as homestead, etc)
 #     OPTIMIZE=1              Enables backend optimizer
 #     ABI_ENCODER_V2=1        Enables ABI encoder version 2
+#     CSE_ACROSS_BLOCKS=1     Enables common subexpression elimination across blocks
 #     SOLTEST_FLAGS=<flags>   Appends <flags> to default SOLTEST_ARGS
 #
 # ------------------------------------------------------------------------------
@@ -50,6 +51,7 @@ get_logfile_basename() {
     local filename="${EVM}"
     test "${OPTIMIZE}" = "1" && filename="${filename}_opt"
     test "${ABI_ENCODER_V2}" = "1" && filename="${filename}_abiv2"
+    test "${CSE_ACROSS_BLOCKS}" = "1" && filename="${filename}_cse_across_blocks"
 
     echo -ne "${filename}"
 }
@@ -58,6 +60,7 @@ BOOST_TEST_ARGS="--color_output=no --show_progress=yes --logger=JUNIT,error,test
 SOLTEST_ARGS="--evm-version=$EVM $SOLTEST_FLAGS"
 test "${OPTIMIZE}" = "1" && SOLTEST_ARGS="${SOLTEST_ARGS} --optimize"
 test "${ABI_ENCODER_V2}" = "1" && SOLTEST_ARGS="${SOLTEST_ARGS} --abiencoderv2 --optimize-yul"
+test "${CSE_ACROSS_BLOCKS}" = "1" && SOLTEST_ARGS="${SOLTEST_ARGS} --optimize-cse-across-blocks"
 
 echo "Running ${REPODIR}/build/test/soltest ${BOOST_TEST_ARGS} -- ${SOLTEST_ARGS}"
 
@@ -35,3 +35,4 @@ for OPTIMIZE in 0 1; do
 done
 
 EVM=istanbul OPTIMIZE=1 ABI_ENCODER_V2=1 ${REPODIR}/.circleci/soltest.sh
+EVM=istanbul OPTIMIZE=1 CSE_ACROSS_BLOCKS=1 ${REPODIR}/.circleci/soltest.sh
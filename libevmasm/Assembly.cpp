@@ -29,7 +29,10 @@
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
 
+#include <libsolutil/Parallel.h>
+
 #include <fstream>
+#include <functional>
 #include <json/json.h>
 
 using namespace std;
@@ -373,6 +376,7 @@ Assembly& Assembly::optimise(bool _enable, EVMVersion _evmVersion, bool _isCreat
 	settings.runPeephole = true;
 	if (_enable)
 	{
+		settings.runExtendedPeephole = true;
 		settings.runDeduplicate = true;
 		settings.runCSE = true;
 		settings.runConstantOptimiser = true;
@@ -396,17 +400,41 @@ map<u256, u256> Assembly::optimiseInternal(
 )
 {
 	// Run optimisation for sub-assemblies.
-	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	if (_settings.maxThreads <= 1 || m_subs.size() <= 1)
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		{
+			OptimiserSettings settings = _settings;
+			// Disable creation mode for sub-assemblies.
+			settings.isCreation = false;
+			map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
+				settings,
+				JumpdestRemover::referencedTags(m_items, subId)
+			);
+			// Apply the replacements (can be empty).
+			BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+		}
+	else
 	{
+		// The replacements of a sub-assembly only affect the tags pushed for this sub-assembly,
+		// so the sub-assemblies can be optimised independently and the replacements can be
+		// applied afterwards in the original order.
+		vector<set<size_t>> referencedTags;
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			referencedTags.emplace_back(JumpdestRemover::referencedTags(m_items, subId));
+
+		vector<vector<size_t>> groups = groupsOfSharedSubs();
 		OptimiserSettings settings = _settings;
 		// Disable creation mode for sub-assemblies.
 		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
-		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+		settings.maxThreads = max<size_t>(1, _settings.maxThreads / groups.size());
+		vector<map<u256, u256>> subTagReplacements(m_subs.size());
+		parallelFor(groups.size(), _settings.maxThreads, [&](size_t _group) {
+			for (size_t subId: groups[_group])
+				subTagReplacements[subId] = m_subs[subId]->optimiseInternal(settings, move(referencedTags[subId]));
+		});
+
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId], subId);
 	}
 
 	map<u256, u256> tagReplacements;
@@ -424,7 +452,7 @@ map<u256, u256> Assembly::optimiseInternal(
 
 		if (_settings.runPeephole)
 		{
-			PeepholeOptimiser peepOpt{m_items};
+			PeepholeOptimiser peepOpt{m_items, _settings.runExtendedPeephole};
 			while (peepOpt.optimise())
 			{
 				count++;
@@ -467,11 +495,20 @@ map<u256, u256> Assembly::optimiseInternal(
 
 			bool usesMSize = (find(m_items.begin(), m_items.end(), AssemblyItem{Instruction::MSIZE}) != m_items.end());
 
+			// If all jumps into this assembly originate in it, the knowledge gathered along the
+			// control flow graph holds at the start of the blocks.
+			map<size_t, KnownStatePointer> blockStartStates;
+			if (_settings.runCSEAcrossBlocks && _tagsReferencedFromOutside.empty())
+				blockStartStates = ControlFlowGraph{m_items}.knowledgeAtBlockStarts();
+
 			auto iter = m_items.begin();
 			while (iter != m_items.end())
 			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
+				KnownState initialState;
+				auto blockStart = blockStartStates.find(size_t(iter - m_items.begin()));
+				if (blockStart != blockStartStates.end())
+					initialState = blockStart->second->relativeToStack();
+				CommonSubexpressionEliminator eliminator{initialState};
 				auto orig = iter;
 				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
 				bool shouldReplace = false;
@@ -519,6 +556,51 @@ map<u256, u256> Assembly::optimiseInternal(
 	return tagReplacements;
 }
 
+vector<vector<size_t>> Assembly::groupsOfSharedSubs() const
+{
+	// Sub-assemblies can be shared, e.g. the creation code of a contract that is created
+	// in both the creation and the runtime code of another contract. Optimising such an
+	// assembly modifies it, so sub-assemblies that reach a common assembly are put into
+	// the same group, in their original order.
+	vector<size_t> groupOf(m_subs.size());
+	function<size_t(size_t)> findGroup = [&](size_t _subId) -> size_t
+	{
+		if (groupOf[_subId] != _subId)
+			groupOf[_subId] = findGroup(groupOf[_subId]);
+		return groupOf[_subId];
+	};
+	map<Assembly const*, size_t> assemblyOwners;
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	{
+		groupOf[subId] = subId;
+		vector<Assembly const*> toVisit{m_subs[subId].get()};
+		while (!toVisit.empty())
+		{
+			Assembly const* assembly = toVisit.back();
+			toVisit.pop_back();
+			auto [owner, inserted] = assemblyOwners.emplace(assembly, subId);
+			if (!inserted)
+			{
+				groupOf[findGroup(owner->second)] = findGroup(subId);
+				continue;
+			}
+			for (auto const& sub: assembly->m_subs)
+				toVisit.push_back(sub.get());
+		}
+	}
+
+	vector<vector<size_t>> groups;
+	map<size_t, size_t> groupIndices;
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	{
+		auto [groupIndex, inserted] = groupIndices.emplace(findGroup(subId), groups.size());
+		if (inserted)
+			groups.emplace_back();
+		groups[groupIndex->second].push_back(subId);
+	}
+	return groups;
+}
+
 LinkerObject const& Assembly::assemble() const
 {
 	// Return the already assembled object, if present.
@@ -52,6 +52,7 @@ public:
 	AssemblyItem newSub(AssemblyPointer const& _sub) { m_subs.push_back(_sub); return AssemblyItem(PushSub, m_subs.size() - 1); }
 	Assembly const& sub(size_t _sub) const { return *m_subs.at(_sub); }
 	Assembly& sub(size_t _sub) { return *m_subs.at(_sub); }
+	size_t numSubs() const { return m_subs.size(); }
 	AssemblyItem newPushSubSize(u256 const& _subId) { return AssemblyItem(PushSubSize, _subId); }
 	AssemblyItem newPushLibraryAddress(std::string const& _identifier);
 	AssemblyItem newPushImmutable(std::string const& _identifier);
@@ -105,13 +106,21 @@ public:
 		bool isCreation = false;
 		bool runJumpdestRemover = false;
 		bool runPeephole = false;
+		/// Lets the peephole optimiser apply additional rules, only used if the optimiser is enabled.
+		bool runExtendedPeephole = false;
 		bool runDeduplicate = false;
 		bool runCSE = false;
+		/// Seeds the common subexpression eliminator with the knowledge about storage and memory
+		/// at the start of each block, gathered along the control flow graph.
+		/// Only used for assemblies whose tags are not referenced from outside.
+		bool runCSEAcrossBlocks = false;
 		bool runConstantOptimiser = false;
 		langutil::EVMVersion evmVersion;
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = 200;
+		/// Maximum number of threads used to optimise independent sub-assemblies.
+		size_t maxThreads = 1;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -145,6 +154,9 @@ protected:
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
 	std::map<u256, u256> optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	/// @returns the indices of the sub-assemblies grouped such that sub-assemblies in
+	/// different groups do not share any assemblies and can be optimised concurrently.
+	std::vector<std::vector<size_t>> groupsOfSharedSubs() const;
 
 	unsigned bytesRequired(unsigned subTagSize) const;
 
@@ -0,0 +1,71 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Process-wide memo for the results of constant optimisation.
+ */
+
+#pragma once
+
+#include <map>
+#include <mutex>
+
+namespace solidity::evmasm
+{
+
+/**
+ * Process-wide memo for the results of constant optimisation, so that constants that occur in
+ * many assemblies or compiler runs are only optimised once for the same settings.
+ * Used by the assembly and the Yul constant optimisers. Can be used from multiple threads.
+ */
+template <class Key, class Value>
+class ConstantOptimisationMemo
+{
+public:
+	/// @returns the memoised result for @a _key or computes it using @a _compute and stores it.
+	/// The computation itself does not hold the lock.
+	template <class Compute>
+	Value get(Key const& _key, Compute const& _compute)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto it = m_results.find(_key);
+			if (it != m_results.end())
+				return it->second;
+		}
+		Value result = _compute();
+		std::lock_guard<std::mutex> lock(m_mutex);
+		// Bounds the memory usage of long-running processes.
+		if (m_results.size() >= maxSize)
+			m_results.clear();
+		m_results.emplace(_key, result);
+		return result;
+	}
+
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_results.clear();
+	}
+
+private:
+	static size_t constexpr maxSize = 0x10000;
+
+	std::mutex m_mutex;
+	std::map<Key, Value> m_results;
+};
+
+}
@@ -21,13 +21,41 @@
 
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
+#include <libevmasm/ConstantOptimisationMemo.h>
 #include <libevmasm/GasMeter.h>
 #include <libsolutil/CommonData.h>
 
+#include <tuple>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
+namespace
+{
+
+/// The cheapest way to represent a constant and the code computing it, if it is computed.
+struct ChosenMethod
+{
+	enum Method { Literal, CodeCopy, Compute };
+	Method method = Literal;
+	AssemblyItems routine;
+};
+
+/// Memo keyed by the constant, the EVM version, creation mode, runs and multiplicity.
+using MethodMemo = ConstantOptimisationMemo<
+	std::tuple<u256, langutil::EVMVersion, bool, size_t, size_t>,
+	ChosenMethod
+>;
+
+MethodMemo& methodMemo()
+{
+	static MethodMemo memo;
+	return memo;
+}
+
+}
+
 unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
@@ -54,21 +82,35 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 		params.isCreation = _isCreation;
 		params.runs = _runs;
 		params.evmVersion = _evmVersion;
-		LiteralMethod lit(params, item.data());
-		bigint literalGas = lit.gasNeeded();
-		CodeCopyMethod copy(params, item.data());
-		bigint copyGas = copy.gasNeeded();
-		ComputeMethod compute(params, item.data());
-		bigint computeGas = compute.gasNeeded();
+		ChosenMethod chosen = methodMemo().get(
+			{item.data(), _evmVersion, _isCreation, _runs, it.second},
+			[&]() {
+				LiteralMethod lit(params, item.data());
+				bigint literalGas = lit.gasNeeded();
+				CodeCopyMethod copy(params, item.data());
+				bigint copyGas = copy.gasNeeded();
+				ComputeMethod compute(params, item.data());
+				bigint computeGas = compute.gasNeeded();
+				ChosenMethod result;
+				if (copyGas < literalGas && copyGas < computeGas)
+					result.method = ChosenMethod::CodeCopy;
+				else if (computeGas < literalGas && computeGas <= copyGas)
+				{
+					result.method = ChosenMethod::Compute;
+					result.routine = compute.execute(_assembly);
+				}
+				return result;
+			}
+		);
 		AssemblyItems replacement;
-		if (copyGas < literalGas && copyGas < computeGas)
+		if (chosen.method == ChosenMethod::CodeCopy)
 		{
-			replacement = copy.execute(_assembly);
+			replacement = CodeCopyMethod(params, item.data()).execute(_assembly);
 			optimisations++;
 		}
-		else if (computeGas < literalGas && computeGas <= copyGas)
+		else if (chosen.method == ChosenMethod::Compute)
 		{
-			replacement = compute.execute(_assembly);
+			replacement = move(chosen.routine);
 			optimisations++;
 		}
 		if (!replacement.empty())
@@ -55,6 +55,29 @@ BasicBlocks ControlFlowGraph::optimisedBlocks()
 	return rebuildCode();
 }
 
+map<size_t, KnownStatePointer> ControlFlowGraph::knowledgeAtBlockStarts()
+{
+	if (m_items.empty())
+		return {};
+
+	findLargestTag();
+	splitBlocks();
+	resolveNextLinks();
+	removeUnusedBlocks();
+	gatherKnowledge();
+
+	map<size_t, KnownStatePointer> states;
+	for (auto const& idAndBlock: m_blocks)
+	{
+		BasicBlock const& block = idAndBlock.second;
+		size_t begin = block.begin;
+		if (begin < block.end && m_items.at(begin).type() == Tag)
+			begin++;
+		states[begin] = block.startState;
+	}
+	return states;
+}
+
 void ControlFlowGraph::findLargestTag()
 {
 	m_lastUsedId = 0;
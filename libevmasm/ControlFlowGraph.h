@@ -106,6 +106,13 @@ public:
 	/// Should be called only once.
 	BasicBlocks optimisedBlocks();
 
+	/// Analyses the control flow without changing the code and @returns the knowledge about
+	/// the state at the start of all reachable blocks, indexed by the position of the first item
+	/// of the block that is not a tag.
+	/// The result is only valid if no tags of the code are pushed outside of it.
+	/// Should be called only once.
+	std::map<size_t, KnownStatePointer> knowledgeAtBlockStarts();
+
 private:
 	void findLargestTag();
 	void splitBlocks();
@@ -26,6 +26,7 @@
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/SimplificationRules.h>
 
+#include <boost/functional/hash.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/noncopyable.hpp>
 
@@ -57,6 +58,31 @@ bool ExpressionClasses::Expression::operator<(ExpressionClasses::Expression cons
 			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
 }
 
+bool ExpressionClasses::Expression::operator==(ExpressionClasses::Expression const& _other) const
+{
+	assertThrow(!!item && !!_other.item, OptimizerException, "");
+	if (item->type() != _other.item->type() || sequenceNumber != _other.sequenceNumber || arguments != _other.arguments)
+		return false;
+	else if (item->type() == Operation)
+		return item->instruction() == _other.item->instruction();
+	else
+		return item->data() == _other.item->data();
+}
+
+void ExpressionClasses::Expression::computeHash()
+{
+	assertThrow(!!item, OptimizerException, "");
+	hash = 0;
+	boost::hash_combine(hash, unsigned(item->type()));
+	if (item->type() == Operation)
+		boost::hash_combine(hash, unsigned(item->instruction()));
+	else
+		for (unsigned i = 0; i < 4; ++i)
+			boost::hash_combine(hash, static_cast<uint64_t>(item->data() >> (64 * i)));
+	boost::hash_combine(hash, arguments);
+	boost::hash_combine(hash, sequenceNumber);
+}
+
 ExpressionClasses::Id ExpressionClasses::find(
 	AssemblyItem const& _item,
 	Ids const& _arguments,
@@ -72,6 +98,7 @@ ExpressionClasses::Id ExpressionClasses::find(
 
 	if (SemanticInformation::isCommutativeOperation(_item))
 		sort(exp.arguments.begin(), exp.arguments.end());
+	exp.computeHash();
 
 	if (SemanticInformation::isDeterministic(_item))
 	{
@@ -109,6 +136,7 @@ void ExpressionClasses::forceEqual(
 
 	if (SemanticInformation::isCommutativeOperation(_item))
 		sort(exp.arguments.begin(), exp.arguments.end());
+	exp.computeHash();
 
 	if (_copyItem)
 		exp.item = storeItem(_item);
@@ -121,6 +149,7 @@ ExpressionClasses::Id ExpressionClasses::newClass(SourceLocation const& _locatio
 	Expression exp;
 	exp.id = m_representatives.size();
 	exp.item = storeItem(AssemblyItem(UndefinedItem, (u256(1) << 255) + exp.id, _location));
+	exp.computeHash();
 	m_representatives.push_back(exp);
 	m_expressions.insert(exp);
 	return exp.id;
@@ -185,7 +214,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rules store the match groups of the last match, so every thread needs its own copy.
+	thread_local Rules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
@@ -30,6 +30,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <unordered_set>
 
 namespace solidity::langutil
 {
@@ -59,8 +60,14 @@ public:
 		Ids arguments;
 		/// Storage modification sequence, only used for storage and memory operations.
 		unsigned sequenceNumber = 0;
+		/// Hash of the tuple below, computed once before the expression is stored.
+		size_t hash = 0;
 		/// Behaves as if this was a tuple of (item->type(), item->data(), arguments, sequenceNumber).
 		bool operator<(Expression const& _other) const;
+		/// Behaves as if this was a tuple of (item->type(), item->data(), arguments, sequenceNumber).
+		bool operator==(Expression const& _other) const;
+		/// Computes the hash of this expression and stores it in @a hash.
+		void computeHash();
 	};
 
 	/// Retrieves the id of the expression equivalence class resulting from the given item applied to the
@@ -118,10 +125,15 @@ private:
 
 	std::vector<std::pair<Pattern, std::function<Pattern()>>> createRules() const;
 
+	struct ExpressionHash
+	{
+		size_t operator()(Expression const& _expression) const { return _expression.hash; }
+	};
+
 	/// Expression equivalence class representatives - we only store one item of an equivalence.
 	std::vector<Expression> m_representatives;
 	/// All expression ever encountered.
-	std::set<Expression> m_expressions;
+	std::unordered_set<Expression, ExpressionHash> m_expressions;
 	std::vector<std::shared_ptr<AssemblyItem>> m_spareAssemblyItems;
 };
 
@@ -26,6 +26,7 @@
 #include <libsolutil/Keccak256.h>
 
 #include <functional>
+#include <optional>
 
 using namespace std;
 using namespace solidity;
@@ -92,9 +93,15 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 		// can be ignored
 	}
 	else if (_item.type() == AssignImmutable)
-		// Since AssignImmutable breaks blocks, it should be fine to only consider its changes to the stack, which
-		// is the same as POP.
+	{
+		// AssignImmutable stores the value in memory at the offsets of the immutable in the
+		// runtime code, which are only known after assembly, and pops it. Since it breaks
+		// blocks, only the loss of the knowledge about memory matters, e.g. when the state is
+		// propagated along the control flow graph.
+		m_memoryContent.clear();
+		m_sequenceNumber += 2;
 		return feedItem(AssemblyItem(Instruction::POP), _copyItem);
+	}
 	else if (_item.type() != Operation)
 	{
 		assertThrow(_item.deposit() == 1, InvalidDeposit, "");
@@ -221,9 +228,10 @@ void KnownState::reduceToCommonKnowledge(KnownState const& _other, bool _combine
 	// Use the smaller stack height. Essential to terminate in case of loops.
 	if (m_stackHeight > _other.m_stackHeight)
 	{
-		map<int, Id> shiftedStack;
+		StackElements shiftedStack;
+		shiftedStack.reserve(m_stackElements.size());
 		for (auto const& stackElement: m_stackElements)
-			shiftedStack[stackElement.first - stackDiff] = stackElement.second;
+			shiftedStack.emplace_hint(shiftedStack.end(), stackElement.first - stackDiff, stackElement.second);
 		m_stackElements = move(shiftedStack);
 		m_stackHeight = _other.m_stackHeight;
 	}
@@ -234,6 +242,48 @@ void KnownState::reduceToCommonKnowledge(KnownState const& _other, bool _combine
 		m_sequenceNumber = max(m_sequenceNumber, _other.m_sequenceNumber);
 }
 
+KnownState KnownState::relativeToStack() const
+{
+	// The retained facts only state that a storage or memory slot given by a constant or a stack
+	// element holds a constant or a stack element. Such a fact holds on every path the analysis
+	// joined, since its expression classes are equal on all of them, no matter which values the
+	// classes stand for. So, unlike the full state, this does not depend on the sequence numbers
+	// at JUMPDESTs (see the todo in ControlFlowGraph::gatherKnowledge).
+	KnownState state;
+	map<Id, Id> translatedClasses;
+	// Use the topmost occurrence of a class. Tag unions are skipped because equal
+	// unions do not imply equal values.
+	for (auto const& [height, id]: m_stackElements)
+		if (height <= m_stackHeight && !m_tagUnions.left.count(id))
+		{
+			AssemblyItem const* item = m_expressionClasses->representative(id).item;
+			translatedClasses[id] = state.stackElement(
+				height - m_stackHeight,
+				item ? item->location() : SourceLocation{}
+			);
+		}
+
+	auto translate = [&](Id _id) -> optional<Id>
+	{
+		if (translatedClasses.count(_id))
+			return translatedClasses.at(_id);
+		AssemblyItem const* item = m_expressionClasses->representative(_id).item;
+		if (item && item->type() == Push)
+			return state.m_expressionClasses->find(AssemblyItem(item->data(), item->location()));
+		return nullopt;
+	};
+	auto translateContent = [&](SlotContents const& _content, SlotContents& _translatedContent)
+	{
+		for (auto const& [slot, value]: _content)
+			if (auto translatedSlot = translate(slot))
+				if (auto translatedValue = translate(value))
+					_translatedContent[*translatedSlot] = *translatedValue;
+	};
+	translateContent(m_storageContent, state.m_storageContent);
+	translateContent(m_memoryContent, state.m_memoryContent);
+	return state;
+}
+
 bool KnownState::operator==(KnownState const& _other) const
 {
 	if (m_storageContent != _other.m_storageContent || m_memoryContent != _other.m_memoryContent)
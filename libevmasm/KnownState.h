@@ -30,6 +30,7 @@
 #include <tuple>
 #include <memory>
 #include <ostream>
+#include <unordered_map>
 
 #if defined(__clang__)
 #pragma clang diagnostic push
@@ -37,6 +38,8 @@
 #endif // defined(__clang__)
 
 #include <boost/bimap.hpp>
+#include <boost/container/flat_map.hpp>
+#include <boost/functional/hash.hpp>
 
 #if defined(__clang__)
 #pragma clang diagnostic pop
@@ -70,6 +73,11 @@ class KnownState
 {
 public:
 	using Id = ExpressionClasses::Id;
+	/// Maps stack heights to equivalence classes. The maps in this class only hold a few
+	/// elements, so sorted vectors are faster than node-based maps and keep the same order.
+	using StackElements = boost::container::flat_map<int, Id>;
+	/// Maps storage or memory slots to the equivalence classes of their contents.
+	using SlotContents = boost::container::flat_map<Id, Id>;
 	struct StoreOperation
 	{
 		enum Target { Invalid, Memory, Storage };
@@ -115,6 +123,12 @@ public:
 	/// @returns a shared pointer to a copy of this state.
 	std::shared_ptr<KnownState> copy() const { return std::make_shared<KnownState>(*this); }
 
+	/// @returns a new state with its own expression classes and the current stack top at height
+	/// zero. It only retains the knowledge about storage and memory whose slots and values are
+	/// constants or elements currently on the stack, so that it can be used as the initial state
+	/// of a CommonSubexpressionEliminator at the start of a block.
+	KnownState relativeToStack() const;
+
 	/// @returns true if the knowledge about the state of both objects is (known to be) equal.
 	bool operator==(KnownState const& _other) const;
 
@@ -132,10 +146,10 @@ public:
 	void clearTagUnions();
 
 	int stackHeight() const { return m_stackHeight; }
-	std::map<int, Id> const& stackElements() const { return m_stackElements; }
+	StackElements const& stackElements() const { return m_stackElements; }
 	ExpressionClasses& expressionClasses() const { return *m_expressionClasses; }
 
-	std::map<Id, Id> const& storageContent() const { return m_storageContent; }
+	SlotContents const& storageContent() const { return m_storageContent; }
 
 private:
 	/// Assigns a new equivalence class to the next sequence number of the given stack element.
@@ -164,16 +178,16 @@ private:
 	/// Current stack height, can be negative.
 	int m_stackHeight = 0;
 	/// Current stack layout, mapping stack height -> equivalence class
-	std::map<int, Id> m_stackElements;
+	StackElements m_stackElements;
 	/// Current sequence number, this is incremented with each modification to storage or memory.
 	unsigned m_sequenceNumber = 1;
 	/// Knowledge about storage content.
-	std::map<Id, Id> m_storageContent;
+	SlotContents m_storageContent;
 	/// Knowledge about memory content. Keys are memory addresses, note that the values overlap
 	/// and are not contained here if they are not completely known.
-	std::map<Id, Id> m_memoryContent;
+	SlotContents m_memoryContent;
 	/// Keeps record of all Keccak-256 hashes that are computed.
-	std::map<std::vector<Id>, Id> m_knownKeccak256Hashes;
+	std::unordered_map<std::vector<Id>, Id, boost::hash<std::vector<Id>>> m_knownKeccak256Hashes;
 	/// Structure containing the classes of equivalent expressions.
 	std::shared_ptr<ExpressionClasses> m_expressionClasses;
 	/// Container for unions of tags stored on the stack.
@@ -24,6 +24,8 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <array>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -33,11 +35,14 @@ using namespace solidity::evmasm;
 namespace
 {
 
-struct OptimiserState
+/// A rule that replaces a window of a fixed number of consecutive items.
+struct Rule
 {
-	AssemblyItems const& items;
-	size_t i;
-	std::back_insert_iterator<AssemblyItems> out;
+	size_t windowSize;
+	/// @returns true if a window starting with the given item can match. Only depends on the
+	/// type of the item and, for operations, on the instruction.
+	bool (*startsWith)(AssemblyItem const&);
+	bool (*apply)(AssemblyItems::const_iterator, std::back_insert_iterator<AssemblyItems>);
 };
 
 template <class Method, size_t Arguments>
@@ -68,72 +73,79 @@ struct ApplyRule<Method, 2>
 		return Method::applySimple(_in[0], _in[1], _out);
 	}
 };
-template <class Method>
-struct ApplyRule<Method, 1>
-{
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
-	{
-		return Method::applySimple(_in[0], _out);
-	}
-};
 
 template <class Method, size_t WindowSize>
 struct SimplePeepholeOptimizerMethod
 {
-	static bool apply(OptimiserState& _state)
+	static Rule rule()
 	{
-		if (
-			_state.i + WindowSize <= _state.items.size() &&
-			ApplyRule<Method, WindowSize>::applyRule(_state.items.begin() + _state.i, _state.out)
-		)
-		{
-			_state.i += WindowSize;
-			return true;
-		}
-		else
-			return false;
+		return Rule{WindowSize, &Method::startsWith, &ApplyRule<Method, WindowSize>::applyRule};
 	}
 };
 
-struct Identity: SimplePeepholeOptimizerMethod<Identity, 1>
+/// @returns true if the item pushes a value without any side effects that does not change
+/// during the execution.
+bool isPushWithoutSideEffects(AssemblyItem const& _item)
 {
-	static bool applySimple(AssemblyItem const& _item, std::back_insert_iterator<AssemblyItems> _out)
-	{
-		*_out = _item;
-		return true;
-	}
-};
+	auto t = _item.type();
+	return
+		t == Push || t == PushString || t == PushTag || t == PushSub ||
+		t == PushSubSize || t == PushProgramSize || t == PushData || t == PushLibraryAddress;
+}
 
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop, 2>
 {
+	static bool startsWith(AssemblyItem const& _push)
+	{
+		return SemanticInformation::isDupInstruction(_push) || isPushWithoutSideEffects(_push);
+	}
 	static bool applySimple(AssemblyItem const& _push, AssemblyItem const& _pop, std::back_insert_iterator<AssemblyItems>)
 	{
-		auto t = _push.type();
-		return _pop == Instruction::POP && (
-			SemanticInformation::isDupInstruction(_push) ||
-			t == Push || t == PushString || t == PushTag || t == PushSub ||
-			t == PushSubSize || t == PushProgramSize || t == PushData || t == PushLibraryAddress
-		);
+		return _pop == Instruction::POP && startsWith(_push);
 	}
 };
 
 struct OpPop: SimplePeepholeOptimizerMethod<OpPop, 2>
 {
+	static bool startsWith(AssemblyItem const& _op)
+	{
+		if (_op.type() != Operation)
+			return false;
+		Instruction instr = _op.instruction();
+		return instructionInfo(instr).ret == 1 && !instructionInfo(instr).sideEffects;
+	}
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _pop,
 		std::back_insert_iterator<AssemblyItems> _out
 	)
 	{
-		if (_pop == Instruction::POP && _op.type() == Operation)
+		if (_pop == Instruction::POP && startsWith(_op))
 		{
-			Instruction instr = _op.instruction();
-			if (instructionInfo(instr).ret == 1 && !instructionInfo(instr).sideEffects)
-			{
-				for (int j = 0; j < instructionInfo(instr).args; j++)
-					*_out = {Instruction::POP, _op.location()};
-				return true;
-			}
+			for (int j = 0; j < instructionInfo(_op.instruction()).args; j++)
+				*_out = {Instruction::POP, _op.location()};
+			return true;
+		}
+		return false;
+	}
+};
+
+/// Removes an operation without side effects or a push right before a STOP.
+struct OpStop: SimplePeepholeOptimizerMethod<OpStop, 2>
+{
+	static bool startsWith(AssemblyItem const& _op)
+	{
+		if (_op.type() == Operation)
+			return !instructionInfo(_op.instruction()).sideEffects;
+		else
+			return _op.type() == Push;
+	}
+	static bool applySimple(AssemblyItem const& _op, AssemblyItem const& _stop, std::back_insert_iterator<AssemblyItems> _out)
+	{
+		if (_stop == Instruction::STOP && startsWith(_op))
+		{
+			*_out = _stop;
+			return true;
 		}
 		return false;
 	}
@@ -141,14 +153,44 @@ struct OpPop: SimplePeepholeOptimizerMethod<OpPop, 2>
 
 struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap, 2>
 {
+	static bool startsWith(AssemblyItem const& _s1)
+	{
+		return SemanticInformation::isSwapInstruction(_s1);
+	}
 	static size_t applySimple(AssemblyItem const& _s1, AssemblyItem const& _s2, std::back_insert_iterator<AssemblyItems>)
 	{
 		return _s1 == _s2 && SemanticInformation::isSwapInstruction(_s1);
 	}
 };
 
+/// Removes a swap that exchanges a value with its own duplicate.
+struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap, 2>
+{
+	static bool startsWith(AssemblyItem const& _dup)
+	{
+		return SemanticInformation::isDupInstruction(_dup);
+	}
+	static bool applySimple(AssemblyItem const& _dup, AssemblyItem const& _swap, std::back_insert_iterator<AssemblyItems> _out)
+	{
+		if (
+			SemanticInformation::isDupInstruction(_dup) &&
+			SemanticInformation::isSwapInstruction(_swap) &&
+			getDupNumber(_dup.instruction()) == getSwapNumber(_swap.instruction())
+		)
+		{
+			*_out = _dup;
+			return true;
+		}
+		return false;
+	}
+};
+
 struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush, 2>
 {
+	static bool startsWith(AssemblyItem const& _push)
+	{
+		return _push.type() == Push;
+	}
 	static bool applySimple(AssemblyItem const& _push1, AssemblyItem const& _push2, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		if (_push1.type() == Push && _push2.type() == Push && _push1.data() == _push2.data())
@@ -162,8 +204,66 @@ struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush, 2>
 	}
 };
 
+/// Replaces the second of two equal pushes of data, a sub-assembly or another value without
+/// side effects that is not a constant by DUP1, as DoublePush does for constants. Pushed tags
+/// are kept, as JumpToNext could not remove a jump to the next tag anymore.
+struct DoubleOtherPush: SimplePeepholeOptimizerMethod<DoubleOtherPush, 2>
+{
+	static bool startsWith(AssemblyItem const& _push)
+	{
+		return _push.type() != Push && _push.type() != PushTag && isPushWithoutSideEffects(_push);
+	}
+	static bool applySimple(AssemblyItem const& _push1, AssemblyItem const& _push2, std::back_insert_iterator<AssemblyItems> _out)
+	{
+		if (startsWith(_push1) && _push1 == _push2)
+		{
+			*_out = _push1;
+			*_out = {Instruction::DUP1, _push2.location()};
+			return true;
+		}
+		else
+			return false;
+	}
+};
+
+/// Replaces the second stack element by a pushed or duplicated value by popping it first.
+struct PushSwapPop: SimplePeepholeOptimizerMethod<PushSwapPop, 3>
+{
+	static bool startsWith(AssemblyItem const& _push)
+	{
+		return isPushWithoutSideEffects(_push) || SemanticInformation::isDupInstruction(_push);
+	}
+	static bool applySimple(
+		AssemblyItem const& _push,
+		AssemblyItem const& _swap,
+		AssemblyItem const& _pop,
+		std::back_insert_iterator<AssemblyItems> _out
+	)
+	{
+		if (_swap != Instruction::SWAP1 || _pop != Instruction::POP)
+			return false;
+		if (isPushWithoutSideEffects(_push))
+		{
+			*_out = {Instruction::POP, _pop.location()};
+			*_out = _push;
+			return true;
+		}
+		else if (SemanticInformation::isDupInstruction(_push) && _push != Instruction::DUP1)
+		{
+			*_out = {Instruction::POP, _pop.location()};
+			*_out = {dupInstruction(getDupNumber(_push.instruction()) - 1), _push.location()};
+			return true;
+		}
+		return false;
+	}
+};
+
 struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap, 2>
 {
+	static bool startsWith(AssemblyItem const& _swap)
+	{
+		return _swap == Instruction::SWAP1;
+	}
 	static bool applySimple(AssemblyItem const& _swap, AssemblyItem const& _op, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		// Remove SWAP1 if following instruction is commutative
@@ -182,6 +282,10 @@ struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap, 2>
 
 struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison, 2>
 {
+	static bool startsWith(AssemblyItem const& _swap)
+	{
+		return _swap == Instruction::SWAP1;
+	}
 	static bool applySimple(AssemblyItem const& _swap, AssemblyItem const& _op, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		static map<Instruction, Instruction> const swappableOps{
@@ -207,6 +311,10 @@ struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison, 2>
 
 struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI, 4>
 {
+	static bool startsWith(AssemblyItem const& _iszero)
+	{
+		return _iszero == Instruction::ISZERO;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _iszero1,
 		AssemblyItem const& _iszero2,
@@ -233,6 +341,10 @@ struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI, 4>
 
 struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext, 3>
 {
+	static bool startsWith(AssemblyItem const& _pushTag)
+	{
+		return _pushTag.type() == PushTag;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _jump,
@@ -259,6 +371,10 @@ struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext, 3>
 
 struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions, 3>
 {
+	static bool startsWith(AssemblyItem const& _pushTag)
+	{
+		return _pushTag.type() == PushTag;
+	}
 	static bool applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _pushConstant,
@@ -283,6 +399,10 @@ struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions, 3>
 
 struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd, 3>
 {
+	static bool startsWith(AssemblyItem const& _push)
+	{
+		return _push.type() == Push;
+	}
 	static bool applySimple(
 		AssemblyItem const& _push,
 		AssemblyItem const& _not,
@@ -298,68 +418,296 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd, 3>
 	}
 };
 
-/// Removes everything after a JUMP (or similar) until the next JUMPDEST.
-struct UnreachableCode
+/// @returns true if the item ends the execution or jumps unconditionally, i.e. if the code
+/// after it is unreachable until the next JUMPDEST.
+bool isUnconditionalExit(AssemblyItem const& _item)
+{
+	return
+		_item == Instruction::JUMP ||
+		_item == Instruction::RETURN ||
+		_item == Instruction::STOP ||
+		_item == Instruction::INVALID ||
+		_item == Instruction::SELFDESTRUCT ||
+		_item == Instruction::REVERT;
+}
+
+/// @returns true if @a _type is the last item type. The switch makes the compiler warn if
+/// item types are added without updating it.
+constexpr bool isLastItemType(AssemblyItemType _type)
 {
-	static bool apply(OptimiserState& _state)
+	switch (_type)
 	{
-		auto it = _state.items.begin() + _state.i;
-		auto end = _state.items.end();
-		if (it == end)
-			return false;
-		if (
-			it[0] != Instruction::JUMP &&
-			it[0] != Instruction::RETURN &&
-			it[0] != Instruction::STOP &&
-			it[0] != Instruction::INVALID &&
-			it[0] != Instruction::SELFDESTRUCT &&
-			it[0] != Instruction::REVERT
-		)
-			return false;
+	case UndefinedItem:
+	case Operation:
+	case Push:
+	case PushString:
+	case PushTag:
+	case PushSub:
+	case PushSubSize:
+	case PushProgramSize:
+	case Tag:
+	case PushData:
+	case PushLibraryAddress:
+	case PushDeployTimeAddress:
+	case PushImmutable:
+		return false;
+	case AssignImmutable:
+		return true;
+	}
+	return false;
+}
 
-		size_t i = 1;
-		while (it + i != end && it[i].type() != Tag)
-			i++;
-		if (i > 1)
-		{
-			*_state.out = it[0];
-			_state.i += i;
-			return true;
-		}
+static_assert(isLastItemType(AssignImmutable), "RuleTable assumes AssignImmutable to be the last item type.");
+
+/// Rules indexed by the kind of the first item of their window (its type or, for operations,
+/// its instruction), so that only the rules that can match are tried.
+class RuleTable
+{
+public:
+	static size_t constexpr maxWindowSize = 4;
+
+	explicit RuleTable(vector<Rule> const& _rules): m_rules(numberOfKinds), m_rulesBySize(numberOfKinds)
+	{
+		vector<AssemblyItem> representatives;
+		for (unsigned type = UndefinedItem; type <= AssignImmutable; ++type)
+			if (type != Operation)
+				representatives.emplace_back(AssemblyItemType(type));
+		for (auto const& nameAndInstruction: c_instructions)
+			representatives.emplace_back(nameAndInstruction.second);
+		for (AssemblyItem const& item: representatives)
+			for (Rule const& rule: _rules)
+			{
+				assertThrow(rule.windowSize <= maxWindowSize, OptimizerException, "");
+				if (rule.startsWith(item))
+				{
+					m_rules[kind(item)].push_back(rule);
+					m_rulesBySize[kind(item)][rule.windowSize].push_back(rule);
+				}
+			}
+	}
+
+	/// @returns the rules whose window can start with @a _first, in the order they were given.
+	vector<Rule> const& rules(AssemblyItem const& _first) const
+	{
+		return m_rules[kind(_first)];
+	}
+
+	vector<Rule> const& rules(AssemblyItem const& _first, size_t _windowSize) const
+	{
+		return m_rulesBySize[kind(_first)][_windowSize];
+	}
+
+private:
+	static size_t constexpr numberOfKinds = size_t(AssignImmutable) + 1 + 0x100;
+
+	static size_t kind(AssemblyItem const& _item)
+	{
+		if (_item.type() == Operation)
+			return size_t(AssignImmutable) + 1 + size_t(_item.instruction());
 		else
-			return false;
+			return size_t(_item.type());
 	}
+
+	vector<vector<Rule>> m_rules;
+	vector<array<vector<Rule>, maxWindowSize + 1>> m_rulesBySize;
 };
 
-void applyMethods(OptimiserState&)
+RuleTable const& ruleTable(bool _extendedRules)
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	static RuleTable const table{{
+		PushPop::rule(), OpPop::rule(), DoublePush::rule(), DoubleSwap::rule(), CommutativeSwap::rule(),
+		SwapComparison::rule(), IsZeroIsZeroJumpI::rule(), JumpToNext::rule(), TagConjunctions::rule(),
+		TruthyAnd::rule()
+	}};
+	// Rules that change the code without the optimiser, only applied if it is enabled.
+	static RuleTable const extendedTable{{
+		PushPop::rule(), OpPop::rule(), OpStop::rule(), DoublePush::rule(), DoubleOtherPush::rule(),
+		DoubleSwap::rule(), DupSwap::rule(), PushSwapPop::rule(), CommutativeSwap::rule(),
+		SwapComparison::rule(), IsZeroIsZeroJumpI::rule(), JumpToNext::rule(), TagConjunctions::rule(),
+		TruthyAnd::rule()
+	}};
+	return _extendedRules ? extendedTable : table;
 }
 
-template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+size_t numberOfPops(AssemblyItems const& _items)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	return std::count(_items.begin(), _items.end(), Instruction::POP);
 }
 
-size_t numberOfPops(AssemblyItems const& _items)
+/// @returns true if @a _replacement has less items than @a _original or as many items, but
+/// less bytes or more POPs.
+bool isImprovement(
+	AssemblyItems::const_iterator _originalBegin,
+	AssemblyItems::const_iterator _originalEnd,
+	AssemblyItems::const_iterator _replacementBegin,
+	AssemblyItems::const_iterator _replacementEnd
+)
 {
-	return std::count(_items.begin(), _items.end(), Instruction::POP);
+	size_t originalSize = size_t(_originalEnd - _originalBegin);
+	size_t replacementSize = size_t(_replacementEnd - _replacementBegin);
+	if (replacementSize != originalSize)
+		return replacementSize < originalSize;
+	auto bytes = [](auto _begin, auto _end) {
+		size_t bytes = 0;
+		for (auto it = _begin; it != _end; ++it)
+			bytes += it->bytesRequired(3);
+		return bytes;
+	};
+	return
+		bytes(_replacementBegin, _replacementEnd) < bytes(_originalBegin, _originalEnd) ||
+		std::count(_replacementBegin, _replacementEnd, Instruction::POP) >
+		std::count(_originalBegin, _originalEnd, Instruction::POP);
+}
+
+/// Applies the first rule that matches at every position from left to right and continues after
+/// the replaced window. Everything after an unconditional exit is removed up to the next tag.
+void applyRulesLeftToRight(RuleTable const& _table, AssemblyItems const& _items, AssemblyItems& _output)
+{
+	size_t i = 0;
+	while (i < _items.size())
+	{
+		bool applied = false;
+		for (Rule const& rule: _table.rules(_items[i]))
+			if (i + rule.windowSize <= _items.size() && rule.apply(_items.begin() + ptrdiff_t(i), back_inserter(_output)))
+			{
+				i += rule.windowSize;
+				applied = true;
+				break;
+			}
+		if (applied)
+			continue;
+		_output.push_back(_items[i]);
+		if (isUnconditionalExit(_items[i]))
+			while (i + 1 < _items.size() && _items[i + 1].type() != Tag)
+				i++;
+		i++;
+	}
+}
+
+/// Finds a rule that applies to a window at the end of @a _items, preferring longer windows.
+/// If @a _onlyImprovements is true, rules whose replacement is not an improvement are skipped.
+/// @returns the size of the window, or zero if no rule applies, and stores its replacement in
+/// @a _replacement.
+size_t matchAtEnd(RuleTable const& _table, AssemblyItems const& _items, AssemblyItems& _replacement, bool _onlyImprovements)
+{
+	for (size_t windowSize = min(RuleTable::maxWindowSize, _items.size()); windowSize > 0; --windowSize)
+	{
+		auto window = _items.end() - ptrdiff_t(windowSize);
+		for (Rule const& rule: _table.rules(*window, windowSize))
+		{
+			_replacement.clear();
+			if (
+				rule.apply(window, back_inserter(_replacement)) &&
+				(!_onlyImprovements || isImprovement(window, _items.end(), _replacement.begin(), _replacement.end()))
+			)
+				return windowSize;
+		}
+	}
+	return 0;
+}
+
+/// Moves the items one by one to the output and only tries rules on windows ending at the last
+/// output item. The replacement of a window is put back to the input, so that it is examined
+/// again together with the few items before it. Thus, no rule applies to the output after a
+/// single sweep, unless its replacement was rejected.
+/// A replacement that is not an improvement on its own, like OpPop turning ADDMOD POP into three
+/// POPs, is only kept if it is one together with the replacements it leads to until its items
+/// are processed, which are checked in the same way. Otherwise, the output is restored and only
+/// improving rules are tried on it.
+/// Every rule reduces the number of items that are neither POP nor DUP, or keeps it and reduces
+/// the number of items, so the sweep terminates.
+/// @returns true if anything was changed.
+bool applyRulesInSingleSweep(RuleTable const& _table, AssemblyItems const& _items, AssemblyItems& _output)
+{
+	/// State before a replacement that is not an improvement on its own.
+	struct Checkpoint
+	{
+		AssemblyItems output;
+		/// Number of pending items that are not part of the replacement.
+		size_t pendingSize;
+		/// Number of output items that were not touched since the checkpoint.
+		size_t unchangedOutputSize;
+		bool changed;
+	};
+
+	AssemblyItems pending(_items.rbegin(), _items.rend());
+	AssemblyItems replacement;
+	vector<Checkpoint> checkpoints;
+	bool changed = false;
+	auto replaceAtEnd = [&](size_t _windowSize)
+	{
+		_output.erase(_output.end() - ptrdiff_t(_windowSize), _output.end());
+		pending.insert(pending.end(), replacement.rbegin(), replacement.rend());
+		for (Checkpoint& checkpoint: checkpoints)
+			checkpoint.unchangedOutputSize = min(checkpoint.unchangedOutputSize, _output.size());
+		changed = true;
+	};
+	while (true)
+	{
+		if (!checkpoints.empty() && pending.size() <= checkpoints.back().pendingSize)
+		{
+			Checkpoint restorable = move(checkpoints.back());
+			checkpoints.pop_back();
+			size_t unchanged = restorable.unchangedOutputSize;
+			if (!isImprovement(
+				restorable.output.begin() + ptrdiff_t(unchanged),
+				restorable.output.end(),
+				_output.begin() + ptrdiff_t(unchanged),
+				_output.end()
+			))
+			{
+				_output = move(restorable.output);
+				changed = restorable.changed;
+				if (size_t windowSize = matchAtEnd(_table, _output, replacement, true))
+					replaceAtEnd(windowSize);
+			}
+			continue;
+		}
+		if (pending.empty())
+			break;
+		if (
+			!_output.empty() &&
+			isUnconditionalExit(_output.back()) &&
+			pending.back().type() != Tag
+		)
+		{
+			// Remove unreachable code until the next JUMPDEST.
+			pending.pop_back();
+			changed = true;
+			continue;
+		}
+		_output.push_back(move(pending.back()));
+		pending.pop_back();
+		if (size_t windowSize = matchAtEnd(_table, _output, replacement, false))
+		{
+			auto window = _output.end() - ptrdiff_t(windowSize);
+			if (!isImprovement(window, _output.end(), replacement.begin(), replacement.end()))
+				checkpoints.push_back(Checkpoint{_output, pending.size(), _output.size() - windowSize, changed});
+			replaceAtEnd(windowSize);
+		}
+	}
+	return changed;
 }
 
 }
 
 bool PeepholeOptimiser::optimise()
 {
-	OptimiserState state {m_items, 0, std::back_inserter(m_optimisedItems)};
-	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
+	m_optimisedItems.clear();
+	m_optimisedItems.reserve(m_items.size());
+	if (m_extendedRules)
+	{
+		// Replacements are checked when they are applied, so the result of the sweep is always used.
+		// Since windows are matched at the end of the output and longer windows are preferred,
+		// the rules can be applied in a different order than from left to right, which can
+		// lead to a different fixpoint.
+		if (!applyRulesInSingleSweep(ruleTable(true), m_items, m_optimisedItems))
+			return false;
+		m_items = std::move(m_optimisedItems);
+		return true;
+	}
+
+	applyRulesLeftToRight(ruleTable(false), m_items, m_optimisedItems);
 	if (m_optimisedItems.size() < m_items.size() || (
 		m_optimisedItems.size() == m_items.size() && (
 			evmasm::bytesRequired(m_optimisedItems, 3) < evmasm::bytesRequired(m_items, 3) ||
@@ -40,13 +40,17 @@ public:
 class PeepholeOptimiser
 {
 public:
-	explicit PeepholeOptimiser(AssemblyItems& _items): m_items(_items) {}
+	/// @param _extendedRules if true, also applies the rules that are only used if the
+	/// optimiser is enabled.
+	explicit PeepholeOptimiser(AssemblyItems& _items, bool _extendedRules = false):
+		m_items(_items), m_extendedRules(_extendedRules) {}
 	virtual ~PeepholeOptimiser() = default;
 
 	bool optimise();
 
 private:
 	AssemblyItems& m_items;
+	bool m_extendedRules = false;
 	AssemblyItems m_optimisedItems;
 };
 
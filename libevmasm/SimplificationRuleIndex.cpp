@@ -0,0 +1,54 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Index of simplification rules by the shape of the expressions they can match.
+ */
+
+#include <libevmasm/SimplificationRuleIndex.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+
+void SimplificationRuleIndex::addRule(Instruction _instruction, Shape const& _shape)
+{
+	m_ruleShapes[uint8_t(_instruction)].push_back(_shape);
+	m_candidates.clear();
+}
+
+vector<size_t> const& SimplificationRuleIndex::candidates(Instruction _instruction, Shape const& _shape)
+{
+	uint64_t key = uint8_t(_instruction);
+	for (ArgumentKind kind: _shape)
+		key = (key << 16) | kind;
+
+	auto [it, inserted] = m_candidates.try_emplace(key);
+	if (inserted)
+	{
+		vector<Shape> const& ruleShapes = m_ruleShapes[uint8_t(_instruction)];
+		for (size_t i = 0; i < ruleShapes.size(); ++i)
+		{
+			bool possibleMatch = true;
+			for (size_t j = 0; j < MaxArguments; ++j)
+				if (ruleShapes[i][j] != Other && ruleShapes[i][j] != _shape[j])
+					possibleMatch = false;
+			if (possibleMatch)
+				it->second.push_back(i);
+		}
+	}
+	return it->second;
+}
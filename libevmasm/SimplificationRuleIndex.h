@@ -0,0 +1,70 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Index of simplification rules by the shape of the expressions they can match.
+ */
+
+#pragma once
+
+#include <libevmasm/Instruction.h>
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace solidity::evmasm
+{
+
+/**
+ * Index of the simplification rules for each instruction by the kinds of the direct
+ * arguments of the expressions they can match. It is used by the rule engines of both the
+ * legacy and the Yul optimiser.
+ *
+ * Most rules already fail because of one of the direct arguments of the expression, so the
+ * rules that can possibly match expressions of a given shape are computed once and the
+ * remaining rules are skipped without walking their patterns. The candidates are returned in
+ * the order in which the rules were added, so the first matching rule does not change.
+ */
+class SimplificationRuleIndex
+{
+public:
+	/// Kind of an argument. Expressions that are neither constants nor operations have kind
+	/// Other. In patterns, Other is used for arguments that can match any expression.
+	using ArgumentKind = uint16_t;
+	static constexpr ArgumentKind Other = 0;
+	static constexpr ArgumentKind Constant = 1;
+	static ArgumentKind operation(Instruction _instruction) { return ArgumentKind(2 + uint8_t(_instruction)); }
+
+	/// Number of leading arguments that are taken into account.
+	static constexpr size_t MaxArguments = 3;
+	using Shape = std::array<ArgumentKind, MaxArguments>;
+
+	/// Registers the next rule for @a _instruction whose pattern requires the argument kinds @a _shape.
+	void addRule(Instruction _instruction, Shape const& _shape);
+
+	/// @returns the indices of the rules for @a _instruction, in the order they were added, that can
+	/// match an expression whose arguments are of the kinds @a _shape.
+	std::vector<size_t> const& candidates(Instruction _instruction, Shape const& _shape);
+
+private:
+	std::vector<Shape> m_ruleShapes[256];
+	/// Cache of the candidates for each combination of instruction and argument kinds.
+	std::unordered_map<uint64_t, std::vector<size_t>> m_candidates;
+};
+
+}
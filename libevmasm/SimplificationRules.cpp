@@ -40,6 +40,21 @@ using namespace solidity;
 using namespace solidity::evmasm;
 using namespace solidity::langutil;
 
+namespace
+{
+
+SimplificationRuleIndex::ArgumentKind argumentKind(AssemblyItem const* _item)
+{
+	if (_item && _item->type() == Push)
+		return SimplificationRuleIndex::Constant;
+	else if (_item && _item->type() == Operation)
+		return SimplificationRuleIndex::operation(_item->instruction());
+	else
+		return SimplificationRuleIndex::Other;
+}
+
+}
+
 SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	Expression const& _expr,
 	ExpressionClasses const& _classes
@@ -48,8 +63,14 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	resetMatchGroups();
 
 	assertThrow(_expr.item, OptimizerException, "");
-	for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
+	Instruction instruction = _expr.item->instruction();
+	SimplificationRuleIndex::Shape shape{};
+	for (size_t i = 0; i < min(shape.size(), _expr.arguments.size()); ++i)
+		shape[i] = argumentKind(_classes.representative(_expr.arguments[i]).item);
+
+	for (size_t index: m_index.candidates(instruction, shape))
 	{
+		auto const& rule = m_rules[uint8_t(instruction)][index];
 		if (rule.pattern.matches(_expr, _classes))
 			if (!rule.feasible || rule.feasible())
 				return &rule;
@@ -72,7 +93,16 @@ void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
 
 void Rules::addRule(SimplificationRule<Pattern> const& _rule)
 {
+	SimplificationRuleIndex::Shape shape{};
+	vector<Pattern> arguments = _rule.pattern.arguments();
+	for (size_t i = 0; i < min(shape.size(), arguments.size()); ++i)
+		if (arguments[i].type() == Push)
+			shape[i] = SimplificationRuleIndex::Constant;
+		else if (arguments[i].type() == Operation)
+			shape[i] = SimplificationRuleIndex::operation(arguments[i].instruction());
+
 	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	m_index.addRule(_rule.pattern.instruction(), shape);
 }
 
 Rules::Rules()
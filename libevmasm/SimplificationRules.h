@@ -25,6 +25,7 @@
 
 #include <libevmasm/ExpressionClasses.h>
 #include <libevmasm/SimplificationRule.h>
+#include <libevmasm/SimplificationRuleIndex.h>
 
 #include <libsolutil/CommonData.h>
 
@@ -74,6 +75,8 @@ private:
 	/// Pattern to match, replacement to be applied and flag indicating whether
 	/// the replacement might remove some elements (except constants).
 	std::vector<SimplificationRule<Pattern>> m_rules[256];
+	/// Rules in m_rules that can match expressions of a given shape.
+	SimplificationRuleIndex m_index;
 };
 
 /**
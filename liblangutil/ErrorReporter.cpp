@@ -86,6 +86,26 @@ void ErrorReporter::error(Error::Type _type, SourceLocation const& _location, Se
 	m_errorList.push_back(err);
 }
 
+bool ErrorReporter::appendWithinLimits(ErrorList const& _errorList)
+{
+	unsigned warningCount = 0;
+	unsigned errorCount = 0;
+	for (auto const& error: _errorList)
+		if (error->type() == Error::Type::Warning)
+			warningCount++;
+		else
+			errorCount++;
+
+	// Below the limits, no error would be dropped and no message about the limits would be added.
+	if (m_warningCount + warningCount >= c_maxWarningsAllowed || m_errorCount + errorCount >= c_maxErrorsAllowed)
+		return false;
+
+	m_warningCount += warningCount;
+	m_errorCount += errorCount;
+	m_errorList += _errorList;
+	return true;
+}
+
 bool ErrorReporter::hasExcessiveErrors() const
 {
 	return m_errorCount > c_maxErrorsAllowed;
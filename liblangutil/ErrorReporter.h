@@ -50,6 +50,11 @@ public:
 		m_errorList += _errorList;
 	}
 
+	/// Appends @a _errorList and counts its errors and warnings like reporting them one by one
+	/// would, unless this reaches the maximum number of errors or warnings.
+	/// @returns false without appending anything in that case.
+	bool appendWithinLimits(ErrorList const& _errorList);
+
 	void warning(std::string const& _description);
 
 	void warning(SourceLocation const& _location, std::string const& _description);
@@ -143,4 +143,16 @@ MagicVariableDeclaration const* GlobalContext::currentSuper() const
 	return m_superPointer[m_currentContract].get();
 }
 
+void GlobalContext::retainContracts(set<ContractDefinition const*> const& _contracts)
+{
+	for (auto* pointers: {&m_thisPointer, &m_superPointer})
+		for (auto it = pointers->begin(); it != pointers->end();)
+			if (_contracts.count(it->first))
+				++it;
+			else
+				it = pointers->erase(it);
+	if (!_contracts.count(m_currentContract))
+		m_currentContract = nullptr;
+}
+
 }
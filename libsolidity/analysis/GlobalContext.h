@@ -26,6 +26,7 @@
 #include <boost/noncopyable.hpp>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -47,6 +48,9 @@ public:
 	void setCurrentContract(ContractDefinition const& _contract);
 	MagicVariableDeclaration const* currentThis() const;
 	MagicVariableDeclaration const* currentSuper() const;
+	/// Removes the "this" and "super" declarations of all contracts except @a _contracts.
+	/// Used when contracts that were seen by this context are destroyed.
+	void retainContracts(std::set<ContractDefinition const*> const& _contracts);
 
 	/// @returns a vector of all implicit global declarations excluding "this".
 	std::vector<Declaration const*> declarations() const;
@@ -45,11 +45,15 @@ NameAndTypeResolver::NameAndTypeResolver(
 	m_errorReporter(_errorReporter),
 	m_globalContext(_globalContext)
 {
+	// The global scope is only created and filled once, as the scopes can be reused
+	// together with the global context by another resolver.
 	if (!m_scopes[nullptr])
-		m_scopes[nullptr] = make_shared<DeclarationContainer>();
-	for (Declaration const* declaration: _globalContext.declarations())
 	{
-		solAssert(m_scopes[nullptr]->registerDeclaration(*declaration), "Unable to register global declaration.");
+		m_scopes[nullptr] = make_shared<DeclarationContainer>();
+		for (Declaration const* declaration: _globalContext.declarations())
+		{
+			solAssert(m_scopes[nullptr]->registerDeclaration(*declaration), "Unable to register global declaration.");
+		}
 	}
 }
 
@@ -88,6 +88,9 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	int64_t id() const { return m_id; }
+	/// Adds @a _offset to the identifier of this node. Only used to renumber the nodes
+	/// of a source unit that was parsed independently of the other source units.
+	void shiftID(int64_t _offset) { m_id = size_t(int64_t(m_id) + _offset); }
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
@@ -124,7 +127,7 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
@@ -20,138 +20,167 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/split.hpp>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
-BoolType const TypeProvider::m_boolean{};
-InaccessibleDynamicType const TypeProvider::m_inaccessibleDynamic{};
-
-/// The string and bytes unique_ptrs are initialized when they are first used because
-/// they rely on `byte` being available which we cannot guarantee in the static init context.
-unique_ptr<ArrayType> TypeProvider::m_bytesStorage;
-unique_ptr<ArrayType> TypeProvider::m_bytesMemory;
-unique_ptr<ArrayType> TypeProvider::m_bytesCalldata;
-unique_ptr<ArrayType> TypeProvider::m_stringStorage;
-unique_ptr<ArrayType> TypeProvider::m_stringMemory;
-
-TupleType const TypeProvider::m_emptyTuple{};
-AddressType const TypeProvider::m_payableAddress{StateMutability::Payable};
-AddressType const TypeProvider::m_address{StateMutability::NonPayable};
-
-array<unique_ptr<IntegerType>, 32> const TypeProvider::m_intM{{
-	{make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 4, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 5, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 6, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 7, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 8, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 9, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 10, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 11, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 12, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 13, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 14, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 15, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 16, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 17, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 18, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 19, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 20, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 21, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 22, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 23, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 24, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 25, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 26, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 27, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 28, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 29, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 30, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 31, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Signed)}
-}};
-
-array<unique_ptr<IntegerType>, 32> const TypeProvider::m_uintM{{
-	{make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 4, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 5, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 6, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 7, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 8, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 9, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 10, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 11, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 12, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 13, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 14, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 15, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 16, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 17, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 18, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 19, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 20, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 21, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 22, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 23, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 24, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 25, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 26, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 27, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 28, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 29, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 30, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 31, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Unsigned)}
-}};
-
-array<unique_ptr<FixedBytesType>, 32> const TypeProvider::m_bytesM{{
-	{make_unique<FixedBytesType>(1)},
-	{make_unique<FixedBytesType>(2)},
-	{make_unique<FixedBytesType>(3)},
-	{make_unique<FixedBytesType>(4)},
-	{make_unique<FixedBytesType>(5)},
-	{make_unique<FixedBytesType>(6)},
-	{make_unique<FixedBytesType>(7)},
-	{make_unique<FixedBytesType>(8)},
-	{make_unique<FixedBytesType>(9)},
-	{make_unique<FixedBytesType>(10)},
-	{make_unique<FixedBytesType>(11)},
-	{make_unique<FixedBytesType>(12)},
-	{make_unique<FixedBytesType>(13)},
-	{make_unique<FixedBytesType>(14)},
-	{make_unique<FixedBytesType>(15)},
-	{make_unique<FixedBytesType>(16)},
-	{make_unique<FixedBytesType>(17)},
-	{make_unique<FixedBytesType>(18)},
-	{make_unique<FixedBytesType>(19)},
-	{make_unique<FixedBytesType>(20)},
-	{make_unique<FixedBytesType>(21)},
-	{make_unique<FixedBytesType>(22)},
-	{make_unique<FixedBytesType>(23)},
-	{make_unique<FixedBytesType>(24)},
-	{make_unique<FixedBytesType>(25)},
-	{make_unique<FixedBytesType>(26)},
-	{make_unique<FixedBytesType>(27)},
-	{make_unique<FixedBytesType>(28)},
-	{make_unique<FixedBytesType>(29)},
-	{make_unique<FixedBytesType>(30)},
-	{make_unique<FixedBytesType>(31)},
-	{make_unique<FixedBytesType>(32)}
-}};
-
-array<unique_ptr<MagicType>, 4> const TypeProvider::m_magics{{
-	{make_unique<MagicType>(MagicType::Kind::Block)},
-	{make_unique<MagicType>(MagicType::Kind::Message)},
-	{make_unique<MagicType>(MagicType::Kind::Transaction)},
-	{make_unique<MagicType>(MagicType::Kind::ABI)}
-	// MetaType is stored separately
-}};
+thread_local TypeProvider* TypeProvider::s_current = nullptr;
+
+namespace
+{
+
+/// @returns true if types with the same rich identifier as @a _type are guaranteed to be equal
+/// to it in every respect. This is not the case for function types, whose identifier does not
+/// include the names of the parameters or the declaration, and for rational number types,
+/// whose identifier does not include the compatible bytes type.
+bool identifierDeterminesType(Type const* _type)
+{
+	if (!_type)
+		return true;
+	switch (_type->category())
+	{
+	case Type::Category::Function:
+	case Type::Category::RationalNumber:
+	case Type::Category::Modifier:
+		return false;
+	case Type::Category::Array:
+	{
+		auto const& arrayType = dynamic_cast<ArrayType const&>(*_type);
+		return arrayType.isByteArray() || identifierDeterminesType(arrayType.baseType());
+	}
+	case Type::Category::ArraySlice:
+		return identifierDeterminesType(&dynamic_cast<ArraySliceType const&>(*_type).arrayType());
+	case Type::Category::Mapping:
+	{
+		auto const& mappingType = dynamic_cast<MappingType const&>(*_type);
+		return identifierDeterminesType(mappingType.keyType()) && identifierDeterminesType(mappingType.valueType());
+	}
+	case Type::Category::Tuple:
+		for (auto const* component: dynamic_cast<TupleType const&>(*_type).components())
+			if (!identifierDeterminesType(component))
+				return false;
+		return true;
+	case Type::Category::TypeType:
+		return identifierDeterminesType(dynamic_cast<TypeType const&>(*_type).actualType());
+	case Type::Category::Magic:
+	{
+		auto const& magicType = dynamic_cast<MagicType const&>(*_type);
+		return magicType.kind() != MagicType::Kind::MetaType || identifierDeterminesType(magicType.typeArgument());
+	}
+	default:
+		return true;
+	}
+}
+
+/// Appends the AST nodes @a _type refers to, directly or through its component types, to @a _nodes.
+void collectReferencedNodes(Type const* _type, vector<ASTNode const*>& _nodes)
+{
+	if (!_type)
+		return;
+	switch (_type->category())
+	{
+	case Type::Category::Contract:
+		_nodes.push_back(&dynamic_cast<ContractType const&>(*_type).contractDefinition());
+		break;
+	case Type::Category::Struct:
+		_nodes.push_back(&dynamic_cast<StructType const&>(*_type).structDefinition());
+		break;
+	case Type::Category::Enum:
+		_nodes.push_back(&dynamic_cast<EnumType const&>(*_type).enumDefinition());
+		break;
+	case Type::Category::Module:
+		_nodes.push_back(&dynamic_cast<ModuleType const&>(*_type).sourceUnit());
+		break;
+	case Type::Category::Array:
+		collectReferencedNodes(dynamic_cast<ArrayType const&>(*_type).baseType(), _nodes);
+		break;
+	case Type::Category::ArraySlice:
+		collectReferencedNodes(&dynamic_cast<ArraySliceType const&>(*_type).arrayType(), _nodes);
+		break;
+	case Type::Category::Mapping:
+	{
+		auto const& mappingType = dynamic_cast<MappingType const&>(*_type);
+		collectReferencedNodes(mappingType.keyType(), _nodes);
+		collectReferencedNodes(mappingType.valueType(), _nodes);
+		break;
+	}
+	case Type::Category::Tuple:
+		for (auto const* component: dynamic_cast<TupleType const&>(*_type).components())
+			collectReferencedNodes(component, _nodes);
+		break;
+	case Type::Category::TypeType:
+		collectReferencedNodes(dynamic_cast<TypeType const&>(*_type).actualType(), _nodes);
+		break;
+	case Type::Category::Magic:
+	{
+		auto const& magicType = dynamic_cast<MagicType const&>(*_type);
+		if (magicType.kind() == MagicType::Kind::MetaType)
+			collectReferencedNodes(magicType.typeArgument(), _nodes);
+		break;
+	}
+	case Type::Category::Function:
+	{
+		auto const& functionType = dynamic_cast<FunctionType const&>(*_type);
+		if (functionType.hasDeclaration())
+			_nodes.push_back(&functionType.declaration());
+		if (functionType.bound())
+			collectReferencedNodes(functionType.selfType(), _nodes);
+		for (auto const* parameterType: functionType.parameterTypes())
+			collectReferencedNodes(parameterType, _nodes);
+		for (auto const* returnParameterType: functionType.returnParameterTypes())
+			collectReferencedNodes(returnParameterType, _nodes);
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+/// @returns the key under which @a _type is interned. AST IDs are not unique if the ASTs are
+/// imported, so the key contains the addresses of the referenced nodes in addition to the
+/// rich identifier, which refers to them by ID.
+string internKey(Type const& _type)
+{
+	string key = _type.richIdentifier();
+	vector<ASTNode const*> nodes;
+	collectReferencedNodes(&_type, nodes);
+	for (ASTNode const* node: nodes)
+		key += "@" + to_string(reinterpret_cast<uintptr_t>(node));
+	return key;
+}
+
+}
+
+TypeProvider::Scope::Scope(TypeProvider& _provider):
+	m_previous(s_current)
+{
+	s_current = &_provider;
+}
+
+TypeProvider::Scope::~Scope()
+{
+	s_current = m_previous;
+}
+
+TypeProvider::TypeProvider()
+{
+	for (unsigned i = 0; i < 32; ++i)
+	{
+		m_intM[i] = make_unique<IntegerType>(8 * (i + 1), IntegerType::Modifier::Signed);
+		m_uintM[i] = make_unique<IntegerType>(8 * (i + 1), IntegerType::Modifier::Unsigned);
+		m_bytesM[i] = make_unique<FixedBytesType>(i + 1);
+	}
+	m_magics = {{
+		{make_unique<MagicType>(MagicType::Kind::Block)},
+		{make_unique<MagicType>(MagicType::Kind::Message)},
+		{make_unique<MagicType>(MagicType::Kind::Transaction)},
+		{make_unique<MagicType>(MagicType::Kind::ABI)}
+		// MetaType is stored separately
+	}};
+}
 
 inline void clearCache(Type const& type)
 {
@@ -167,13 +196,40 @@ inline void clearCache(unique_ptr<T> const& type)
 }
 
 template <typename Container>
-inline void clearCaches(Container& container)
+inline void clearCachesOf(Container& container)
 {
 	for (auto const& e: container)
 		clearCache(e);
 }
 
 void TypeProvider::reset()
+{
+	TypeProvider& provider = instance();
+	provider.clearCaches();
+
+	provider.m_internedTypes.clear();
+	for (auto const* type: {
+		provider.m_bytesStorage.get(),
+		provider.m_bytesMemory.get(),
+		provider.m_bytesCalldata.get(),
+		provider.m_stringStorage.get(),
+		provider.m_stringMemory.get()
+	})
+		if (type)
+			provider.registerInterned(type);
+	provider.m_generalTypes.clear();
+	provider.m_stringLiteralTypes.clear();
+	provider.m_ufixedMxN.clear();
+	provider.m_fixedMxN.clear();
+}
+
+void TypeProvider::resetDefault()
+{
+	Scope scope{defaultInstance()};
+	reset();
+}
+
+void TypeProvider::clearCaches()
 {
 	clearCache(m_boolean);
 	clearCache(m_inaccessibleDynamic);
@@ -185,15 +241,41 @@ void TypeProvider::reset()
 	clearCache(m_emptyTuple);
 	clearCache(m_payableAddress);
 	clearCache(m_address);
-	clearCaches(instance().m_intM);
-	clearCaches(instance().m_uintM);
-	clearCaches(instance().m_bytesM);
-	clearCaches(instance().m_magics);
+	clearCachesOf(m_intM);
+	clearCachesOf(m_uintM);
+	clearCachesOf(m_bytesM);
+	clearCachesOf(m_magics);
+}
 
-	instance().m_generalTypes.clear();
-	instance().m_stringLiteralTypes.clear();
-	instance().m_ufixedMxN.clear();
-	instance().m_fixedMxN.clear();
+void TypeProvider::discardTypesReferringTo(set<ASTNode const*> const& _discardedNodes)
+{
+	clearCaches();
+	for (auto const& type: m_generalTypes)
+		type->clearCache();
+	for (auto const& literalType: m_stringLiteralTypes)
+		literalType.second->clearCache();
+	for (auto const& fixedPointType: m_ufixedMxN)
+		fixedPointType.second->clearCache();
+	for (auto const& fixedPointType: m_fixedMxN)
+		fixedPointType.second->clearCache();
+
+	set<Type const*> discardedTypes;
+	vector<unique_ptr<Type>> remainingTypes;
+	for (auto& type: m_generalTypes)
+	{
+		vector<ASTNode const*> nodes;
+		collectReferencedNodes(type.get(), nodes);
+		if (any_of(nodes.begin(), nodes.end(), [&](ASTNode const* _node) { return _discardedNodes.count(_node); }))
+			discardedTypes.insert(type.get());
+		else
+			remainingTypes.emplace_back(move(type));
+	}
+	for (auto it = m_internedTypes.begin(); it != m_internedTypes.end();)
+		if (discardedTypes.count(it->second))
+			it = m_internedTypes.erase(it);
+		else
+			++it;
+	m_generalTypes = move(remainingTypes);
 }
 
 template <typename T, typename... Args>
@@ -203,6 +285,34 @@ inline T const* TypeProvider::createAndGet(Args&& ... _args)
 	return static_cast<T const*>(instance().m_generalTypes.back().get());
 }
 
+template <typename T, typename... Args>
+inline T const* TypeProvider::createAndGetInterned(Args&& ... _args)
+{
+	return static_cast<T const*>(intern(make_unique<T>(std::forward<Args>(_args)...)));
+}
+
+Type const* TypeProvider::intern(unique_ptr<Type> _type)
+{
+	TypeProvider& provider = instance();
+	// The default instance is not reset between unrelated compilations, so interned
+	// types could refer to AST nodes that no longer exist.
+	if (!s_current || !identifierDeterminesType(_type.get()))
+	{
+		provider.m_generalTypes.emplace_back(move(_type));
+		return provider.m_generalTypes.back().get();
+	}
+
+	auto [it, inserted] = provider.m_internedTypes.emplace(internKey(*_type), _type.get());
+	if (inserted)
+		provider.m_generalTypes.emplace_back(move(_type));
+	return it->second;
+}
+
+void TypeProvider::registerInterned(Type const* _type)
+{
+	m_internedTypes.emplace(internKey(*_type), _type);
+}
+
 Type const* TypeProvider::fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability)
 {
 	solAssert(
@@ -305,37 +415,57 @@ TypePointer TypeProvider::fromElementaryTypeName(string const& _name)
 
 ArrayType const* TypeProvider::bytesStorage()
 {
-	if (!m_bytesStorage)
-		m_bytesStorage = make_unique<ArrayType>(DataLocation::Storage, false);
-	return m_bytesStorage.get();
+	TypeProvider& provider = instance();
+	if (!provider.m_bytesStorage)
+	{
+		provider.m_bytesStorage = make_unique<ArrayType>(DataLocation::Storage, false);
+		provider.registerInterned(provider.m_bytesStorage.get());
+	}
+	return provider.m_bytesStorage.get();
 }
 
 ArrayType const* TypeProvider::bytesMemory()
 {
-	if (!m_bytesMemory)
-		m_bytesMemory = make_unique<ArrayType>(DataLocation::Memory, false);
-	return m_bytesMemory.get();
+	TypeProvider& provider = instance();
+	if (!provider.m_bytesMemory)
+	{
+		provider.m_bytesMemory = make_unique<ArrayType>(DataLocation::Memory, false);
+		provider.registerInterned(provider.m_bytesMemory.get());
+	}
+	return provider.m_bytesMemory.get();
 }
 
 ArrayType const* TypeProvider::bytesCalldata()
 {
-	if (!m_bytesCalldata)
-		m_bytesCalldata = make_unique<ArrayType>(DataLocation::CallData, false);
-	return m_bytesCalldata.get();
+	TypeProvider& provider = instance();
+	if (!provider.m_bytesCalldata)
+	{
+		provider.m_bytesCalldata = make_unique<ArrayType>(DataLocation::CallData, false);
+		provider.registerInterned(provider.m_bytesCalldata.get());
+	}
+	return provider.m_bytesCalldata.get();
 }
 
 ArrayType const* TypeProvider::stringStorage()
 {
-	if (!m_stringStorage)
-		m_stringStorage = make_unique<ArrayType>(DataLocation::Storage, true);
-	return m_stringStorage.get();
+	TypeProvider& provider = instance();
+	if (!provider.m_stringStorage)
+	{
+		provider.m_stringStorage = make_unique<ArrayType>(DataLocation::Storage, true);
+		provider.registerInterned(provider.m_stringStorage.get());
+	}
+	return provider.m_stringStorage.get();
 }
 
 ArrayType const* TypeProvider::stringMemory()
 {
-	if (!m_stringMemory)
-		m_stringMemory = make_unique<ArrayType>(DataLocation::Memory, true);
-	return m_stringMemory.get();
+	TypeProvider& provider = instance();
+	if (!provider.m_stringMemory)
+	{
+		provider.m_stringMemory = make_unique<ArrayType>(DataLocation::Memory, true);
+		provider.registerInterned(provider.m_stringMemory.get());
+	}
+	return provider.m_stringMemory.get();
 }
 
 TypePointer TypeProvider::forLiteral(Literal const& _literal)
@@ -400,9 +530,9 @@ FixedPointType const* TypeProvider::fixedPoint(unsigned m, unsigned n, FixedPoin
 TupleType const* TypeProvider::tuple(vector<Type const*> members)
 {
 	if (members.empty())
-		return &m_emptyTuple;
+		return emptyTuple();
 
-	return createAndGet<TupleType>(move(members));
+	return createAndGetInterned<TupleType>(move(members));
 }
 
 ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, DataLocation _location, bool _isPointer)
@@ -410,8 +540,7 @@ ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, Data
 	if (_type->location() == _location && _type->isPointer() == _isPointer)
 		return _type;
 
-	instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
-	return static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	return static_cast<ReferenceType const*>(intern(_type->copyForLocation(_location, _isPointer)));
 }
 
 FunctionType const* TypeProvider::function(FunctionDefinition const& _function, FunctionType::Kind _kind)
@@ -500,47 +629,47 @@ ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
 		if (_location == DataLocation::Memory)
 			return bytesMemory();
 	}
-	return createAndGet<ArrayType>(_location, _isString);
+	return createAndGetInterned<ArrayType>(_location, _isString);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType)
 {
-	return createAndGet<ArrayType>(_location, _baseType);
+	return createAndGetInterned<ArrayType>(_location, _baseType);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType, u256 const& _length)
 {
-	return createAndGet<ArrayType>(_location, _baseType, _length);
+	return createAndGetInterned<ArrayType>(_location, _baseType, _length);
 }
 
 ArraySliceType const* TypeProvider::arraySlice(ArrayType const& _arrayType)
 {
-	return createAndGet<ArraySliceType>(_arrayType);
+	return createAndGetInterned<ArraySliceType>(_arrayType);
 }
 
 ContractType const* TypeProvider::contract(ContractDefinition const& _contractDef, bool _isSuper)
 {
-	return createAndGet<ContractType>(_contractDef, _isSuper);
+	return createAndGetInterned<ContractType>(_contractDef, _isSuper);
 }
 
 EnumType const* TypeProvider::enumType(EnumDefinition const& _enumDef)
 {
-	return createAndGet<EnumType>(_enumDef);
+	return createAndGetInterned<EnumType>(_enumDef);
 }
 
 ModuleType const* TypeProvider::module(SourceUnit const& _source)
 {
-	return createAndGet<ModuleType>(_source);
+	return createAndGetInterned<ModuleType>(_source);
 }
 
 TypeType const* TypeProvider::typeType(Type const* _actualType)
 {
-	return createAndGet<TypeType>(_actualType);
+	return createAndGetInterned<TypeType>(_actualType);
 }
 
 StructType const* TypeProvider::structType(StructDefinition const& _struct, DataLocation _location)
 {
-	return createAndGet<StructType>(_struct, _location);
+	return createAndGetInterned<StructType>(_struct, _location);
 }
 
 ModifierType const* TypeProvider::modifier(ModifierDefinition const& _def)
@@ -551,16 +680,16 @@ ModifierType const* TypeProvider::modifier(ModifierDefinition const& _def)
 MagicType const* TypeProvider::magic(MagicType::Kind _kind)
 {
 	solAssert(_kind != MagicType::Kind::MetaType, "MetaType is handled separately");
-	return m_magics.at(static_cast<size_t>(_kind)).get();
+	return instance().m_magics.at(static_cast<size_t>(_kind)).get();
 }
 
 MagicType const* TypeProvider::meta(Type const* _type)
 {
 	solAssert(_type && _type->category() == Type::Category::Contract, "Only contracts supported for now.");
-	return createAndGet<MagicType>(_type);
+	return createAndGetInterned<MagicType>(_type);
 }
 
 MappingType const* TypeProvider::mapping(Type const* _keyType, Type const* _valueType)
 {
-	return createAndGet<MappingType>(_keyType, _valueType);
+	return createAndGetInterned<MappingType>(_keyType, _valueType);
 }
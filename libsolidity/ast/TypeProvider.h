@@ -23,6 +23,8 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
+#include <unordered_map>
 #include <utility>
 
 namespace solidity::frontend
@@ -36,20 +38,47 @@ namespace solidity::frontend
  *
  * It is not recommended to explicitly instantiate types unless you really know what and why
  * you are doing it.
+ *
+ * The static functions operate on the TypeProvider that is active in the current thread
+ * (see TypeProvider::Scope) or on a default instance of the thread if there is none.
+ * Active providers intern types whose rich identifier and referenced declarations fully
+ * determine them, so that structurally equal types are represented by the same object.
  */
 class TypeProvider
 {
 public:
-	TypeProvider() = default;
-	TypeProvider(TypeProvider&&) = default;
+	/// Makes a TypeProvider the active one in the current thread for the lifetime of this object.
+	class Scope
+	{
+	public:
+		explicit Scope(TypeProvider& _provider);
+		~Scope();
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+	private:
+		TypeProvider* m_previous = nullptr;
+	};
+
+	TypeProvider();
+	TypeProvider(TypeProvider&&) = delete;
 	TypeProvider(TypeProvider const&) = delete;
-	TypeProvider& operator=(TypeProvider&&) = default;
+	TypeProvider& operator=(TypeProvider&&) = delete;
 	TypeProvider& operator=(TypeProvider const&) = delete;
 	~TypeProvider() = default;
 
-	/// Resets state of this TypeProvider to initial state, wiping all mutable types.
+	/// Resets state of the active TypeProvider to initial state, wiping all mutable types.
 	/// This invalidates all dangling pointers to types provided by this TypeProvider.
 	static void reset();
+	/// Resets the default TypeProvider of the current thread, which provides the types
+	/// requested outside of any TypeProvider::Scope.
+	static void resetDefault();
+
+	/// Clears the cached members of all types and removes the types that refer to one of
+	/// @a _discardedNodes, so that the remaining types can be used with new AST nodes.
+	void discardTypesReferringTo(std::set<ASTNode const*> const& _discardedNodes);
+	/// @returns the number of types created by this provider.
+	size_t typeCount() const { return m_generalTypes.size() + m_stringLiteralTypes.size(); }
 
 	/// @name Factory functions
 	/// Factory functions that convert an AST @ref TypeName to a Type.
@@ -60,10 +89,10 @@ public:
 	static TypePointer fromElementaryTypeName(std::string const& _name);
 
 	/// @returns boolean type.
-	static BoolType const* boolean() noexcept { return &m_boolean; }
+	static BoolType const* boolean() noexcept { return &instance().m_boolean; }
 
 	static FixedBytesType const* byte() { return fixedBytes(1); }
-	static FixedBytesType const* fixedBytes(unsigned m) { return m_bytesM.at(m - 1).get(); }
+	static FixedBytesType const* fixedBytes(unsigned m) { return instance().m_bytesM.at(m - 1).get(); }
 
 	static ArrayType const* bytesStorage();
 	static ArrayType const* bytesMemory();
@@ -82,16 +111,16 @@ public:
 
 	static ArraySliceType const* arraySlice(ArrayType const& _arrayType);
 
-	static AddressType const* payableAddress() noexcept { return &m_payableAddress; }
-	static AddressType const* address() noexcept { return &m_address; }
+	static AddressType const* payableAddress() noexcept { return &instance().m_payableAddress; }
+	static AddressType const* address() noexcept { return &instance().m_address; }
 
 	static IntegerType const* integer(unsigned _bits, IntegerType::Modifier _modifier)
 	{
 		solAssert((_bits % 8) == 0, "");
 		if (_modifier == IntegerType::Modifier::Unsigned)
-			return m_uintM.at(_bits / 8 - 1).get();
+			return instance().m_uintM.at(_bits / 8 - 1).get();
 		else
-			return m_intM.at(_bits / 8 - 1).get();
+			return instance().m_intM.at(_bits / 8 - 1).get();
 	}
 	static IntegerType const* uint(unsigned _bits) { return integer(_bits, IntegerType::Modifier::Unsigned); }
 
@@ -105,7 +134,7 @@ public:
 	/// @returns a tuple type with the given members.
 	static TupleType const* tuple(std::vector<Type const*> members);
 
-	static TupleType const* emptyTuple() noexcept { return &m_emptyTuple; }
+	static TupleType const* emptyTuple() noexcept { return &instance().m_emptyTuple; }
 
 	static ReferenceType const* withLocation(ReferenceType const* _type, DataLocation _location, bool _isPointer);
 
@@ -169,7 +198,7 @@ public:
 
 	static ContractType const* contract(ContractDefinition const& _contract, bool _isSuper = false);
 
-	static InaccessibleDynamicType const* inaccessibleDynamic() noexcept { return &m_inaccessibleDynamic; }
+	static InaccessibleDynamicType const* inaccessibleDynamic() noexcept { return &instance().m_inaccessibleDynamic; }
 
 	/// @returns the type of an enum instance for given definition, there is one distinct type per enum definition.
 	static EnumType const* enumType(EnumDefinition const& _enum);
@@ -190,37 +219,61 @@ public:
 	static MappingType const* mapping(Type const* _keyType, Type const* _valueType);
 
 private:
-	/// Global TypeProvider instance.
-	static TypeProvider& instance()
+	/// @returns the TypeProvider that is active in the current thread.
+	static TypeProvider& instance() noexcept
 	{
-		static TypeProvider _provider;
+		if (s_current)
+			return *s_current;
+		return defaultInstance();
+	}
+	static TypeProvider& defaultInstance() noexcept
+	{
+		static thread_local TypeProvider _provider;
 		return _provider;
 	}
 
+	/// Clears the cached members of all types of this provider.
+	void clearCaches();
+
 	template <typename T, typename... Args>
 	static inline T const* createAndGet(Args&& ... _args);
 
-	static BoolType const m_boolean;
-	static InaccessibleDynamicType const m_inaccessibleDynamic;
+	/// Creates a type and @returns the unique instance structurally equal to it.
+	/// Only use for types that are fully determined by their rich identifier.
+	template <typename T, typename... Args>
+	static inline T const* createAndGetInterned(Args&& ... _args);
+
+	/// Stores @a _type unless an equal type has already been interned and @returns the stored type.
+	static Type const* intern(std::unique_ptr<Type> _type);
+
+	/// Registers a lazily-initialized type as the canonical instance of its identifier.
+	void registerInterned(Type const* _type);
+
+	static thread_local TypeProvider* s_current;
+
+	BoolType const m_boolean{};
+	InaccessibleDynamicType const m_inaccessibleDynamic{};
 
 	/// These are lazy-initialized because they depend on `byte` being available.
-	static std::unique_ptr<ArrayType> m_bytesStorage;
-	static std::unique_ptr<ArrayType> m_bytesMemory;
-	static std::unique_ptr<ArrayType> m_bytesCalldata;
-	static std::unique_ptr<ArrayType> m_stringStorage;
-	static std::unique_ptr<ArrayType> m_stringMemory;
-
-	static TupleType const m_emptyTuple;
-	static AddressType const m_payableAddress;
-	static AddressType const m_address;
-	static std::array<std::unique_ptr<IntegerType>, 32> const m_intM;
-	static std::array<std::unique_ptr<IntegerType>, 32> const m_uintM;
-	static std::array<std::unique_ptr<FixedBytesType>, 32> const m_bytesM;
-	static std::array<std::unique_ptr<MagicType>, 4> const m_magics;        ///< MagicType's except MetaType
+	std::unique_ptr<ArrayType> m_bytesStorage;
+	std::unique_ptr<ArrayType> m_bytesMemory;
+	std::unique_ptr<ArrayType> m_bytesCalldata;
+	std::unique_ptr<ArrayType> m_stringStorage;
+	std::unique_ptr<ArrayType> m_stringMemory;
+
+	TupleType const m_emptyTuple{};
+	AddressType const m_payableAddress{StateMutability::Payable};
+	AddressType const m_address{StateMutability::NonPayable};
+	std::array<std::unique_ptr<IntegerType>, 32> m_intM;
+	std::array<std::unique_ptr<IntegerType>, 32> m_uintM;
+	std::array<std::unique_ptr<FixedBytesType>, 32> m_bytesM;
+	std::array<std::unique_ptr<MagicType>, 4> m_magics;        ///< MagicType's except MetaType
 
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_ufixedMxN{};
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
 	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
+	/// Interned types by their rich identifier and the addresses of the AST nodes they refer to.
+	std::unordered_map<std::string, Type const*> m_internedTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
 };
 
@@ -1634,6 +1634,8 @@ string ArrayType::richIdentifier() const
 
 bool ArrayType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	ArrayType const& other = dynamic_cast<ArrayType const&>(_other);
@@ -3475,6 +3477,8 @@ string MappingType::richIdentifier() const
 
 bool MappingType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	MappingType const& other = dynamic_cast<MappingType const&>(_other);
@@ -1419,6 +1419,8 @@ public:
 
 	std::string toString(bool _short) const override;
 
+	SourceUnit const& sourceUnit() const { return m_sourceUnit; }
+
 protected:
 	std::vector<std::tuple<std::string, TypePointer>> makeStackItems() const override { return {}; }
 private:
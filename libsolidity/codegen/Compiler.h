@@ -48,6 +48,23 @@ public:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
 		bytes const& _metadata
 	);
+	/// Generates the code for a contract without running the assembly optimiser.
+	/// Has to be followed by a call to optimise() before the object is assembled.
+	/// @arg _metadata contains the to be injected metadata CBOR
+	void generateCode(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
+		bytes const& _metadata
+	);
+	/// Shares the Yul utility functions with the other contracts of the same compilation.
+	void setYulFunctionMemo(std::shared_ptr<MultiUseYulFunctionMemo> const& _memo)
+	{
+		m_runtimeContext.setYulFunctionMemo(_memo);
+		m_context.setYulFunctionMemo(_memo);
+	}
+	/// Runs the assembly optimiser on the generated code, using up to @a _maxThreads
+	/// threads for independent sub-assemblies.
+	void optimise(size_t _maxThreads = 1) { m_context.optimise(m_optimiserSettings, _maxThreads); }
 	/// @returns Entire assembly.
 	evmasm::Assembly const& assembly() const { return m_context.assembly(); }
 	/// @returns Entire assembly as a shared pointer to non-const.
@@ -37,6 +37,7 @@
 #include <libyul/Object.h>
 #include <libyul/YulString.h>
 
+#include <libsolutil/Profiler.h>
 #include <libsolutil/Whiskers.h>
 
 #include <liblangutil/ErrorReporter.h>
@@ -45,8 +46,11 @@
 
 #include <boost/algorithm/string/replace.hpp>
 
-#include <utility>
+#include <map>
+#include <mutex>
 #include <numeric>
+#include <tuple>
+#include <utility>
 
 // Change to "define" to output all intermediate code
 #undef SOL_OUTPUT_ASM
@@ -62,6 +66,83 @@ using namespace solidity::evmasm;
 using namespace solidity::frontend;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// Everything that influences the result of parsing, analysing and optimising
+/// a code generator inline assembly snippet.
+struct InlineAssemblyCacheKey
+{
+	string assembly;
+	vector<string> localVariables;
+	set<string> externallyUsedFunctions;
+	EVMVersion evmVersion;
+	bool optimize;
+	bool optimizeStackAllocation;
+	size_t expectedExecutionsPerDeployment;
+	bool isCreation;
+
+	bool operator<(InlineAssemblyCacheKey const& _other) const
+	{
+		return
+			tie(assembly, localVariables, externallyUsedFunctions, evmVersion, optimize, optimizeStackAllocation, expectedExecutionsPerDeployment, isCreation) <
+			tie(_other.assembly, _other.localVariables, _other.externallyUsedFunctions, _other.evmVersion, _other.optimize, _other.optimizeStackAllocation, _other.expectedExecutionsPerDeployment, _other.isCreation);
+	}
+};
+
+/// Parsed, analysed and, if requested, optimised inline assembly. Never modified after creation.
+struct InlineAssemblyCacheEntry
+{
+	shared_ptr<yul::Block> code;
+	shared_ptr<yul::AsmAnalysisInfo> analysisInfo;
+};
+
+/// Cache of the inline assembly snippets generated by the code generator, which are
+/// mostly the same small routines over and over again. Shared between all compilations
+/// and cleared together with the YulString repository, whose strings it references.
+class InlineAssemblyCache
+{
+public:
+	InlineAssemblyCache():
+		m_resetCallback{[this] { lock_guard<mutex> lock(m_mutex); m_entries.clear(); }}
+	{}
+
+	shared_ptr<InlineAssemblyCacheEntry const> find(InlineAssemblyCacheKey const& _key)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = m_entries.find(_key);
+		return it == m_entries.end() ? nullptr : it->second;
+	}
+
+	/// Stores @a _entry unless another one was stored for @a _key in the meantime.
+	/// @returns the entry stored for @a _key.
+	shared_ptr<InlineAssemblyCacheEntry const> insert(
+		InlineAssemblyCacheKey _key,
+		shared_ptr<InlineAssemblyCacheEntry const> _entry
+	)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (m_entries.size() >= MaxEntries)
+			m_entries.clear();
+		return m_entries.emplace(move(_key), move(_entry)).first->second;
+	}
+
+private:
+	static size_t constexpr MaxEntries = 8192;
+
+	mutex m_mutex;
+	map<InlineAssemblyCacheKey, shared_ptr<InlineAssemblyCacheEntry const>> m_entries;
+	yul::YulStringRepository::ResetCallback m_resetCallback;
+};
+
+InlineAssemblyCache& inlineAssemblyCache()
+{
+	static InlineAssemblyCache cache;
+	return cache;
+}
+
+}
+
 void CompilerContext::addStateVariable(
 	VariableDeclaration const& _declaration,
 	u256 const& _storageOffset,
@@ -352,6 +433,15 @@ CompilerContext& CompilerContext::appendConditionalRevert(bool _forwardReturnDat
 	return *this;
 }
 
+void CompilerContext::setYulFunctionMemo(shared_ptr<MultiUseYulFunctionMemo> _memo)
+{
+	solAssert(
+		!_memo || (_memo->evmVersion() == m_evmVersion && _memo->revertStrings() == m_revertStrings),
+		"Yul function memo used with different settings."
+	);
+	m_yulFunctionCollector.setMemo(move(_memo));
+}
+
 void CompilerContext::resetVisitedNodes(ASTNode const* _node)
 {
 	stack<ASTNode const*> newStack;
@@ -415,68 +505,89 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
-	ErrorList errors;
-	ErrorReporter errorReporter(errors);
-	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, "--CODEGEN--"));
 	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
-	shared_ptr<yul::Block> parserResult = yul::Parser(errorReporter, dialect).parse(scanner, false);
-#ifdef SOL_OUTPUT_ASM
-	cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
-#endif
-
-	auto reportError = [&](string const& _context)
-	{
-		string message =
-			"Error parsing/analyzing inline assembly block:\n" +
-			_context + "\n"
-			"------------------ Input: -----------------\n" +
-			_assembly + "\n"
-			"------------------ Errors: ----------------\n";
-		for (auto const& error: errorReporter.errors())
-			message += SourceReferenceFormatter::formatErrorInformation(*error);
-		message += "-------------------------------------------\n";
-
-		solAssert(false, message);
-	};
-
-	yul::AsmAnalysisInfo analysisInfo;
-	bool analyzerResult = false;
-	if (parserResult)
-		analyzerResult = yul::AsmAnalyzer(
-			analysisInfo,
-			errorReporter,
-			dialect,
-			identifierAccess.resolve
-		).analyze(*parserResult);
-	if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
-		reportError("Invalid assembly generated by code generator.");
-
 	// Several optimizer steps cannot handle externally supplied stack variables,
 	// so we essentially only optimize the ABI functions.
-	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
+	bool const optimize = _optimiserSettings.runYulOptimiser && _localVariables.empty();
+	InlineAssemblyCacheKey cacheKey{
+		_assembly,
+		_localVariables,
+		_externallyUsedFunctions,
+		m_evmVersion,
+		optimize,
+		optimize && _optimiserSettings.optimizeStackAllocation,
+		optimize ? _optimiserSettings.expectedExecutionsPerDeployment : 0,
+		optimize && runtimeContext() != nullptr
+	};
+	shared_ptr<InlineAssemblyCacheEntry const> cached = inlineAssemblyCache().find(cacheKey);
+	if (!cached)
 	{
-		yul::Object obj;
-		obj.code = parserResult;
-		obj.analysisInfo = make_shared<yul::AsmAnalysisInfo>(analysisInfo);
+		util::Profiler::Timer timer{"codegen.inlineAssembly"};
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, "--CODEGEN--"));
+		shared_ptr<yul::Block> parserResult = yul::Parser(errorReporter, dialect).parse(scanner, false);
+#ifdef SOL_OUTPUT_ASM
+		cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
+#endif
+
+		auto reportError = [&](string const& _context)
+		{
+			string message =
+				"Error parsing/analyzing inline assembly block:\n" +
+				_context + "\n"
+				"------------------ Input: -----------------\n" +
+				_assembly + "\n"
+				"------------------ Errors: ----------------\n";
+			for (auto const& error: errorReporter.errors())
+				message += SourceReferenceFormatter::formatErrorInformation(*error);
+			message += "-------------------------------------------\n";
+
+			solAssert(false, message);
+		};
+
+		auto analysisInfo = make_shared<yul::AsmAnalysisInfo>();
+		bool analyzerResult = false;
+		if (parserResult)
+			analyzerResult = yul::AsmAnalyzer(
+				*analysisInfo,
+				errorReporter,
+				dialect,
+				identifierAccess.resolve
+			).analyze(*parserResult);
+		if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
+			reportError("Invalid assembly generated by code generator.");
+
+		if (optimize)
+		{
+			yul::Object obj;
+			obj.code = parserResult;
+			obj.analysisInfo = analysisInfo;
 
-		optimizeYul(obj, dialect, _optimiserSettings, externallyUsedIdentifiers);
+			optimizeYul(obj, dialect, _optimiserSettings, externallyUsedIdentifiers);
 
-		analysisInfo = std::move(*obj.analysisInfo);
-		parserResult = std::move(obj.code);
+			analysisInfo = std::move(obj.analysisInfo);
+			parserResult = std::move(obj.code);
 
 #ifdef SOL_OUTPUT_ASM
-		cout << "After optimizer:" << endl;
-		cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
+			cout << "After optimizer:" << endl;
+			cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
 #endif
-	}
+		}
 
-	if (!errorReporter.errors().empty())
-		reportError("Failed to analyze inline assembly block.");
+		if (!errorReporter.errors().empty())
+			reportError("Failed to analyze inline assembly block.");
+
+		solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
+		cached = inlineAssemblyCache().insert(
+			move(cacheKey),
+			make_shared<InlineAssemblyCacheEntry const>(InlineAssemblyCacheEntry{move(parserResult), move(analysisInfo)})
+		);
+	}
 
-	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
 	yul::CodeGenerator::assemble(
-		*parserResult,
-		analysisInfo,
+		*cached->code,
+		*cached->analysisInfo,
 		*m_asm,
 		m_evmVersion,
 		identifierAccess,
@@ -531,12 +642,18 @@ void CompilerContext::updateSourceLocation()
 evmasm::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(OptimiserSettings const& _settings)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, m_evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, false, false, m_evmVersion, 0};
 	asmSettings.isCreation = true;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
+	// The additional peephole rules are only applied if the optimiser is enabled, so that the
+	// unoptimised code does not change.
+	asmSettings.runExtendedPeephole = _settings.runPeephole && (
+		_settings.runDeduplicate || _settings.runCSE || _settings.runConstantOptimiser
+	);
 	asmSettings.runDeduplicate = _settings.runDeduplicate;
 	asmSettings.runCSE = _settings.runCSE;
+	asmSettings.runCSEAcrossBlocks = _settings.runCSE && _settings.runCSEAcrossBlocks;
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
 	asmSettings.evmVersion = m_evmVersion;
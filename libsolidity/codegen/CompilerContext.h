@@ -167,6 +167,8 @@ public:
 	/// Clears the internal list, i.e. calling it again will result in an
 	/// empty return value.
 	std::pair<std::string, std::set<std::string>> requestedYulFunctions();
+	/// Shares the Yul utility functions with other contracts of the same compilation.
+	void setYulFunctionMemo(std::shared_ptr<MultiUseYulFunctionMemo> _memo);
 
 	/// Returns the distance of the given local variable from the bottom of the stack (of the current function).
 	unsigned baseStackOffsetOfVariable(Declaration const& _declaration) const;
@@ -268,7 +270,13 @@ public:
 	void appendAuxiliaryData(bytes const& _data) { m_asm->appendAuxiliaryDataToEnd(_data); }
 
 	/// Run optimisation step.
-	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(translateOptimiserSettings(_settings)); }
+	/// Runs the assembly optimiser, using up to @a _maxThreads threads for independent sub-assemblies.
+	void optimise(OptimiserSettings const& _settings, size_t _maxThreads = 1)
+	{
+		evmasm::Assembly::OptimiserSettings settings = translateOptimiserSettings(_settings);
+		settings.maxThreads = _maxThreads;
+		m_asm->optimise(settings);
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
@@ -26,6 +26,8 @@
 #include <boost/algorithm/string/join.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::frontend;
@@ -42,12 +44,83 @@ string MultiUseYulFunctionCollector::requestedFunctions()
 
 string MultiUseYulFunctionCollector::createFunction(string const& _name, function<string ()> const& _creator)
 {
+	recordDependency(_name);
 	if (!m_requestedFunctions.count(_name))
+		create(_name, _creator);
+	return _name;
+}
+
+string MultiUseYulFunctionCollector::createSharedFunction(string const& _name, function<string ()> const& _creator)
+{
+	recordDependency(_name);
+	if (m_requestedFunctions.count(_name))
+		return _name;
+
+	if (m_memo)
+		if (auto function = m_memo->find(_name))
+		{
+			addFromMemo(_name, *function);
+			return _name;
+		}
+
+	vector<string> dependencies = create(_name, _creator);
+	// Functions that depend on contract-specific functions cannot be shared.
+	if (m_memo && all_of(dependencies.begin(), dependencies.end(), [&](string const& _dependency) {
+		return m_memo->find(_dependency) != nullptr;
+	}))
+		m_memo->insert(_name, {m_requestedFunctions.at(_name), move(dependencies)});
+	return _name;
+}
+
+void MultiUseYulFunctionCollector::recordDependency(string const& _name)
+{
+	if (!m_creations.empty())
+		m_creations.back().push_back(_name);
+}
+
+vector<string> MultiUseYulFunctionCollector::create(string const& _name, function<string ()> const& _creator)
+{
+	m_creations.emplace_back();
+	string fun;
+	try
 	{
-		string fun = _creator();
-		solAssert(!fun.empty(), "");
-		solAssert(fun.find("function " + _name) != string::npos, "Function not properly named.");
-		m_requestedFunctions[_name] = std::move(fun);
+		fun = _creator();
 	}
-	return _name;
+	catch (...)
+	{
+		m_creations.pop_back();
+		throw;
+	}
+	vector<string> dependencies = move(m_creations.back());
+	m_creations.pop_back();
+
+	solAssert(!fun.empty(), "");
+	solAssert(fun.find("function " + _name) != string::npos, "Function not properly named.");
+	m_requestedFunctions[_name] = std::move(fun);
+	return dependencies;
+}
+
+void MultiUseYulFunctionCollector::addFromMemo(string const& _name, MultiUseYulFunctionMemo::Function const& _function)
+{
+	m_requestedFunctions[_name] = _function.code;
+	for (string const& dependency: _function.dependencies)
+		if (!m_requestedFunctions.count(dependency))
+		{
+			auto function = m_memo->find(dependency);
+			solAssert(function, "Dependency of shared Yul function not found.");
+			addFromMemo(dependency, *function);
+		}
+}
+
+shared_ptr<MultiUseYulFunctionMemo::Function const> MultiUseYulFunctionMemo::find(string const& _name) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_functions.find(_name);
+	return it == m_functions.end() ? nullptr : it->second;
+}
+
+void MultiUseYulFunctionMemo::insert(string const& _name, Function _function)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_functions.emplace(_name, make_shared<Function const>(move(_function)));
 }
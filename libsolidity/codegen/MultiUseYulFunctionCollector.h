@@ -21,13 +21,56 @@
 
 #pragma once
 
+#include <libsolidity/interface/DebugSettings.h>
+
+#include <liblangutil/EVMVersion.h>
+
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace solidity::frontend
 {
 
+/**
+ * Yul utility functions generated during one compilation, shared between the
+ * function collectors of all contracts. Only holds functions whose code is
+ * determined by their name, the EVM version and the revert strings setting.
+ * Can be used from multiple threads.
+ */
+class MultiUseYulFunctionMemo
+{
+public:
+	struct Function
+	{
+		std::string code;
+		/// Names of the functions called by this function, which have to be
+		/// emitted alongside of it.
+		std::vector<std::string> dependencies;
+	};
+
+	MultiUseYulFunctionMemo(langutil::EVMVersion _evmVersion, RevertStrings _revertStrings):
+		m_evmVersion(_evmVersion),
+		m_revertStrings(_revertStrings)
+	{}
+
+	langutil::EVMVersion evmVersion() const { return m_evmVersion; }
+	RevertStrings revertStrings() const { return m_revertStrings; }
+
+	/// @returns the function with the given name or nullptr if it was not generated yet.
+	std::shared_ptr<Function const> find(std::string const& _name) const;
+	void insert(std::string const& _name, Function _function);
+
+private:
+	langutil::EVMVersion const m_evmVersion;
+	RevertStrings const m_revertStrings;
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::shared_ptr<Function const>> m_functions;
+};
+
 /**
  * Container of (unparsed) Yul functions identified by name which are meant to be generated
  * only once.
@@ -39,6 +82,13 @@ public:
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
 	/// cases.
 	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
+	/// Like createFunction, but for functions whose code only depends on their name, the
+	/// EVM version and the revert strings setting. Their code and the functions they
+	/// depend on are taken from the memo, if one is set, instead of calling @a _creator.
+	std::string createSharedFunction(std::string const& _name, std::function<std::string()> const& _creator);
+
+	/// Sets the memo to share functions created via createSharedFunction with other collectors.
+	void setMemo(std::shared_ptr<MultiUseYulFunctionMemo> _memo) { m_memo = std::move(_memo); }
 
 	/// @returns concatenation of all generated functions.
 	/// Guarantees that the order of functions in the generated code is deterministic and
@@ -51,8 +101,19 @@ public:
 	bool contains(std::string const& _name) const { return m_requestedFunctions.count(_name) > 0; }
 
 private:
+	/// Records @a _name as dependency of the function currently being created.
+	void recordDependency(std::string const& _name);
+	/// Runs @a _creator and stores its result under @a _name.
+	/// @returns the names of the functions requested by @a _creator.
+	std::vector<std::string> create(std::string const& _name, std::function<std::string()> const& _creator);
+	/// Adds @a _name and all its dependencies from the memo.
+	void addFromMemo(std::string const& _name, MultiUseYulFunctionMemo::Function const& _function);
+
 	/// Map from function name to code for a multi-use function.
 	std::map<std::string, std::string> m_requestedFunctions;
+	std::shared_ptr<MultiUseYulFunctionMemo> m_memo;
+	/// Dependencies of the functions currently being created, innermost last.
+	std::vector<std::vector<std::string>> m_creations;
 };
 
 }
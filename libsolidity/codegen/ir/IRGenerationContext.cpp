@@ -32,6 +32,15 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 
+void IRGenerationContext::setYulFunctionMemo(shared_ptr<MultiUseYulFunctionMemo> _memo)
+{
+	solAssert(
+		!_memo || (_memo->evmVersion() == m_evmVersion && _memo->revertStrings() == m_revertStrings),
+		"Yul function memo used with different settings."
+	);
+	m_functions.setMemo(move(_memo));
+}
+
 string IRGenerationContext::enqueueFunctionForCodeGeneration(FunctionDefinition const& _function)
 {
 	string name = functionName(_function);
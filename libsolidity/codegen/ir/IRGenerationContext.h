@@ -61,6 +61,8 @@ public:
 	{}
 
 	MultiUseYulFunctionCollector& functionCollector() { return m_functions; }
+	/// Shares the Yul utility functions with other contracts of the same compilation.
+	void setYulFunctionMemo(std::shared_ptr<MultiUseYulFunctionMemo> _memo);
 
 	/// Adds a Solidity function to the function generation queue and returns the name of the
 	/// corresponding Yul function.
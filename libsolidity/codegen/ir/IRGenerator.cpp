@@ -30,12 +30,16 @@
 #include <libsolidity/codegen/CompilerUtils.h>
 
 #include <libyul/AssemblyStack.h>
+#include <libyul/AsmParser.h>
+#include <libyul/Object.h>
+#include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/Utilities.h>
 
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Whiskers.h>
 #include <libsolutil/StringUtils.h>
 
+#include <liblangutil/ErrorReporter.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -48,12 +52,44 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 
-pair<string, string> IRGenerator::run(ContractDefinition const& _contract)
+string const IRGenerator::warning =
+	"/*******************************************************\n"
+	" *                       WARNING                       *\n"
+	" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
+	" *       It can result in LOSS OF FUNDS or worse       *\n"
+	" *                !USE AT YOUR OWN RISK!               *\n"
+	" *******************************************************/\n\n";
+
+pair<string, shared_ptr<yul::Object>> IRGenerator::run(ContractDefinition const& _contract)
 {
-	string const ir = yul::reindent(generate(_contract));
+	auto [creationCode, runtimeCode] = generate(_contract);
+
+	Whiskers t(R"(
+		object "<CreationObject>" {
+			code <creationCode>
+			object "<RuntimeObject>" {
+				code <runtimeCode>
+			}
+		}
+	)");
+	t("CreationObject", creationObjectName(_contract));
+	t("creationCode", creationCode);
+	t("RuntimeObject", runtimeObjectName(_contract));
+	t("runtimeCode", runtimeCode);
+	string const ir = yul::reindent(t.render());
+
+	// The objects are built directly, only their code is parsed.
+	auto runtimeObject = make_shared<yul::Object>();
+	runtimeObject->name = yul::YulString{runtimeObjectName(_contract)};
+	runtimeObject->code = parse(runtimeCode);
+	auto object = make_shared<yul::Object>();
+	object->name = yul::YulString{creationObjectName(_contract)};
+	object->code = parse(creationCode);
+	object->subIndexByName[runtimeObject->name] = 0;
+	object->subObjects.emplace_back(move(runtimeObject));
 
 	yul::AssemblyStack asmStack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	if (!asmStack.parseAndAnalyze("", ir))
+	if (!asmStack.loadParsed(object))
 	{
 		string errorMessage;
 		for (auto const& error: asmStack.errors())
@@ -62,54 +98,56 @@ pair<string, string> IRGenerator::run(ContractDefinition const& _contract)
 	}
 	asmStack.optimize();
 
-	string warning =
-		"/*******************************************************\n"
-		" *                       WARNING                       *\n"
-		" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
-		" *       It can result in LOSS OF FUNDS or worse       *\n"
-		" *                !USE AT YOUR OWN RISK!               *\n"
-		" *******************************************************/\n\n";
-
-	return {warning + ir, warning + asmStack.print()};
+	// The optimized object is only printed if it is requested.
+	return {warning + ir, asmStack.parserResult()};
 }
 
-string IRGenerator::generate(ContractDefinition const& _contract)
+pair<string, string> IRGenerator::generate(ContractDefinition const& _contract)
 {
 	solUnimplementedAssert(!_contract.isLibrary(), "Libraries not yet implemented.");
 
-	Whiskers t(R"(
-		object "<CreationObject>" {
-			code {
-				<memoryInit>
-				<constructor>
-				<deploy>
-				<functions>
-			}
-			object "<RuntimeObject>" {
-				code {
-					<memoryInit>
-					<dispatch>
-					<runtimeFunctions>
-				}
-			}
-		}
-	)");
-
+	Whiskers creation(R"({
+		<memoryInit>
+		<constructor>
+		<deploy>
+		<functions>
+	})");
 	resetContext(_contract);
-
-	t("CreationObject", creationObjectName(_contract));
-	t("memoryInit", memoryInit());
-	t("constructor", constructorCode(_contract));
-	t("deploy", deployCode(_contract));
+	creation("memoryInit", memoryInit());
+	creation("constructor", constructorCode(_contract));
+	creation("deploy", deployCode(_contract));
 	generateQueuedFunctions();
-	t("functions", m_context.functionCollector().requestedFunctions());
+	creation("functions", m_context.functionCollector().requestedFunctions());
 
+	Whiskers runtime(R"({
+		<memoryInit>
+		<dispatch>
+		<runtimeFunctions>
+	})");
 	resetContext(_contract);
-	t("RuntimeObject", runtimeObjectName(_contract));
-	t("dispatch", dispatchRoutine(_contract));
+	runtime("memoryInit", memoryInit());
+	runtime("dispatch", dispatchRoutine(_contract));
 	generateQueuedFunctions();
-	t("runtimeFunctions", m_context.functionCollector().requestedFunctions());
-	return t.render();
+	runtime("runtimeFunctions", m_context.functionCollector().requestedFunctions());
+
+	return {creation.render(), runtime.render()};
+}
+
+shared_ptr<yul::Block> IRGenerator::parse(string const& _code) const
+{
+	langutil::ErrorList errors;
+	langutil::ErrorReporter errorReporter(errors);
+	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_code, ""));
+	shared_ptr<yul::Block> block =
+		yul::Parser(errorReporter, yul::EVMDialect::strictAssemblyForEVMObjects(m_evmVersion)).parse(scanner, false);
+	if (!block || !errors.empty())
+	{
+		string errorMessage;
+		for (auto const& error: errors)
+			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error);
+		solAssert(false, _code + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
+	}
+	return block;
 }
 
 string IRGenerator::generate(Block const& _block)
@@ -27,8 +27,15 @@
 #include <libsolidity/codegen/ir/IRGenerationContext.h>
 #include <libsolidity/codegen/YulUtilFunctions.h>
 #include <liblangutil/EVMVersion.h>
+#include <memory>
 #include <string>
 
+namespace solidity::yul
+{
+struct Block;
+struct Object;
+}
+
 namespace solidity::frontend
 {
 
@@ -48,13 +55,22 @@ public:
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
 	{}
 
-	/// Generates and returns the IR code, in unoptimized and optimized form
-	/// (or just pretty-printed, depending on the optimizer settings).
-	std::pair<std::string, std::string> run(ContractDefinition const& _contract);
+	/// Shares the Yul utility functions with the other contracts of the same compilation.
+	void setYulFunctionMemo(std::shared_ptr<MultiUseYulFunctionMemo> _memo) { m_context.setYulFunctionMemo(std::move(_memo)); }
+
+	/// Generates and returns the IR code as text and the analyzed object,
+	/// optimized depending on the optimizer settings.
+	std::pair<std::string, std::shared_ptr<yul::Object>> run(ContractDefinition const& _contract);
+
+	/// Comment that precedes the generated and the optimized IR code.
+	static std::string const warning;
 
 private:
-	std::string generate(ContractDefinition const& _contract);
+	/// @returns the code of the creation and of the runtime object.
+	std::pair<std::string, std::string> generate(ContractDefinition const& _contract);
 	std::string generate(Block const& _block);
+	/// Parses a block of generated code.
+	std::shared_ptr<yul::Block> parse(std::string const& _code) const;
 
 	/// Generates code for all the functions from the function generation queue.
 	/// The resulting code is stored in the function collector in IRGenerationContext.
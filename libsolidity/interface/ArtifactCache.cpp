@@ -0,0 +1,101 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * On-disk cache for the results of Standard JSON compilations.
+ */
+
+#include <libsolidity/interface/ArtifactCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+optional<ArtifactCache::Entry> ArtifactCache::load(h256 const& _key) const
+{
+	try
+	{
+		boost::filesystem::path path = entryPath(_key);
+		if (!boost::filesystem::is_regular_file(path))
+			return nullopt;
+
+		Json::Value json;
+		if (!jsonParseStrict(readFileAsString(path.string()), json) || !json.isObject())
+			return nullopt;
+		if (!json["loadedFiles"].isObject() || !json["output"].isObject())
+			return nullopt;
+
+		Entry entry;
+		for (auto const& fileName: json["loadedFiles"].getMemberNames())
+		{
+			Json::Value const& hash = json["loadedFiles"][fileName];
+			if (!hash.isString() || hash.asString().size() != 2 * h256::size)
+				return nullopt;
+			entry.loadedFiles[fileName] = h256(hash.asString(), h256::FromHex, h256::AlignRight);
+		}
+		entry.output = move(json["output"]);
+		return entry;
+	}
+	catch (...)
+	{
+		return nullopt;
+	}
+}
+
+void ArtifactCache::store(h256 const& _key, Entry const& _entry) const
+{
+	Json::Value json{Json::objectValue};
+	json["loadedFiles"] = Json::objectValue;
+	for (auto const& [fileName, hash]: _entry.loadedFiles)
+		json["loadedFiles"][fileName] = hash.hex();
+	json["output"] = _entry.output;
+
+	try
+	{
+		boost::filesystem::create_directories(m_directory);
+		// Write to a temporary file first, so that concurrent readers never see partial entries.
+		boost::filesystem::path temporaryPath =
+			m_directory / boost::filesystem::unique_path(_key.hex() + "-%%%%-%%%%-%%%%.tmp");
+		{
+			ofstream file(temporaryPath.string(), ios::binary | ios::trunc);
+			file << jsonCompactPrint(json);
+			if (!file)
+			{
+				file.close();
+				boost::filesystem::remove(temporaryPath);
+				return;
+			}
+		}
+		boost::filesystem::rename(temporaryPath, entryPath(_key));
+	}
+	catch (...)
+	{
+		// The cache is only an optimisation, so failing to store an entry is not an error.
+	}
+}
+
+boost::filesystem::path ArtifactCache::entryPath(h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
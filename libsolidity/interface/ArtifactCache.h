@@ -0,0 +1,66 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * On-disk cache for the results of Standard JSON compilations.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <json/json.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <map>
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Content-addressed cache that stores one file per key in a directory.
+ * Every entry records the hashes of the files that were loaded through the read callback
+ * during the compilation, so that the entry can be validated before it is used.
+ * Failures to access the directory are not reported and result in cache misses.
+ * Entries are written atomically, so the cache can be shared between processes.
+ */
+class ArtifactCache
+{
+public:
+	struct Entry
+	{
+		/// Keccak-256 hashes of the contents of the files loaded during compilation, by path.
+		std::map<std::string, util::h256> loadedFiles;
+		Json::Value output;
+	};
+
+	explicit ArtifactCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the entry stored under @a _key, if there is a valid one.
+	std::optional<Entry> load(util::h256 const& _key) const;
+	/// Stores @a _entry under @a _key, replacing any previous entry.
+	void store(util::h256 const& _key, Entry const& _entry) const;
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
@@ -39,6 +39,7 @@
 #include <libsolidity/analysis/ImmutableValidator.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/codegen/Compiler.h>
@@ -59,11 +60,14 @@
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
 
+#include <libevmasm/Assembly.h>
 #include <libevmasm/Exceptions.h>
 
 #include <libsolutil/SwarmHash.h>
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Profiler.h>
 
 #include <json/json.h>
 
@@ -78,9 +82,8 @@ using namespace solidity::frontend;
 using solidity::util::errinfo_comment;
 using solidity::util::toHex;
 
-static int g_compilerStackCounts = 0;
-
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
+	m_typeProvider{make_unique<TypeProvider>()},
 	m_readFile{std::move(_readFile)},
 	m_enabledSMTSolvers{smt::SMTSolverChoice::All()},
 	m_generateIR{false},
@@ -88,16 +91,13 @@ CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_errorList{},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
-	++g_compilerStackCounts;
 }
 
 CompilerStack::~CompilerStack()
 {
-	--g_compilerStackCounts;
-	TypeProvider::reset();
+	// Types requested outside of a TypeProvider::Scope, e.g. by callers inspecting the
+	// annotations, are created by the default provider.
+	TypeProvider::resetDefault();
 }
 
 std::optional<CompilerStack::Remapping> CompilerStack::parseRemapping(string const& _remapping)
@@ -172,6 +172,13 @@ void CompilerStack::setRevertStringBehaviour(RevertStrings _revertStrings)
 	m_revertStrings = _revertStrings;
 }
 
+void CompilerStack::setParallelism(unsigned _jobs)
+{
+	if (m_stackState >= ParsingPerformed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set parallelism before parsing."));
+	m_parallelism = max(_jobs, 1u);
+}
+
 void CompilerStack::useMetadataLiteralSources(bool _metadataLiteralSources)
 {
 	if (m_stackState >= ParsingPerformed)
@@ -195,6 +202,10 @@ void CompilerStack::addSMTLib2Response(h256 const& _hash, string const& _respons
 
 void CompilerStack::reset(bool _keepSettings)
 {
+	if (m_incremental && _keepSettings && m_stackState >= AnalysisPerformed && !m_hasError && !m_importedSources)
+		storeIncrementalState();
+	else
+		m_incrementalState.reset();
 	m_stackState = Empty;
 	m_hasError = false;
 	m_sources.clear();
@@ -208,7 +219,11 @@ void CompilerStack::reset(bool _keepSettings)
 		m_enabledSMTSolvers = smt::SMTSolverChoice::All();
 		m_generateIR = false;
 		m_generateEwasm = false;
+		m_generateEvmBytecode = true;
+		m_shareYulFunctions = true;
 		m_revertStrings = RevertStrings::Default;
+		m_parallelism = 1;
+		m_incremental = false;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 		m_metadataHash = MetadataHash::IPFS;
@@ -218,7 +233,9 @@ void CompilerStack::reset(bool _keepSettings)
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
-	TypeProvider::reset();
+	m_typeProvider = make_unique<TypeProvider>();
+	m_typeCountLimit = 0;
+	m_lastNodeID = 0;
 }
 
 void CompilerStack::setSources(StringMap _sources)
@@ -241,30 +258,27 @@ bool CompilerStack::parse()
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning("This is a pre-release compiler version, please do not use it in production.");
 
-	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
-
-	vector<string> sourcesToParse;
-	for (auto const& s: m_sources)
-		sourcesToParse.push_back(s.first);
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
+	util::Profiler::Timer timer{"parsing"};
+	vector<string> sourcesToParse = reuseAnalysedSources();
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
+	if (m_parallelism > 1)
+		parseInParallel(move(sourcesToParse));
+	else
 	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.scanner->reset();
-		source.ast = parser.parse(source.scanner);
-		if (!source.ast)
-			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
-		else
+		Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+		parser.continueNodeIDsAfter(m_lastNodeID);
+		for (size_t i = 0; i < sourcesToParse.size(); ++i)
 		{
-			source.ast->annotation().path = path;
-			for (auto const& newSource: loadMissingSources(*source.ast, path))
-			{
-				string const& newPath = newSource.first;
-				string const& newContents = newSource.second;
-				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
-				sourcesToParse.push_back(newPath);
-			}
+			string const path = sourcesToParse[i];
+			Source& source = m_sources[path];
+			source.scanner->reset();
+			source.ast = parser.parse(source.scanner);
+			if (!source.ast)
+				solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
+			else
+				addImportedSources(path, sourcesToParse);
 		}
+		m_lastNodeID = parser.lastNodeID();
 	}
 
 	m_stackState = ParsingPerformed;
@@ -275,6 +289,7 @@ bool CompilerStack::parse()
 
 void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call importASTs only before the SourcesSet state."));
 	m_sourceJsons = _sources;
@@ -295,77 +310,100 @@ void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 
 bool CompilerStack::analyze()
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState != ParsingPerformed || m_stackState >= AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was performed."));
 	resolveImports();
 
+	// Sources reused in incremental mode are already analysed.
+	vector<Source const*> sourcesToAnalyse;
+	for (Source const* source: m_sourceOrder)
+		if (!source->reused)
+			sourcesToAnalyse.push_back(source);
+
 	bool noErrors = true;
 
 	try
 	{
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
-
-		DocStringAnalyser docStringAnalyser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
-				noErrors = false;
-
-		m_globalContext = make_shared<GlobalContext>();
-		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_scopes, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.registerDeclarations(*source->ast))
-				return false;
-
-		map<string, SourceUnit const*> sourceUnitsByName;
-		for (auto& source: m_sources)
-			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
-				return false;
-
-		// This is the main name and type resolution loop. Needs to be run for every contract, because
-		// the special variables "this" and "super" must be set appropriately.
-		for (Source const* source: m_sourceOrder)
-			if (source->ast)
-				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				{
-					if (!resolver.resolveNamesAndTypes(*node))
-						return false;
-					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+		{
+			util::Profiler::Timer timer{"analysis.syntax"};
+			SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
+			for (Source const* source: sourcesToAnalyse)
+				if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
+					noErrors = false;
+		}
+
+		{
+			util::Profiler::Timer timer{"analysis.docStrings"};
+			DocStringAnalyser docStringAnalyser(m_errorReporter);
+			for (Source const* source: sourcesToAnalyse)
+				if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
+					noErrors = false;
+		}
+
+		{
+			util::Profiler::Timer timer{"analysis.nameAndTypeResolution"};
+			if (!m_globalContext)
+				m_globalContext = make_shared<GlobalContext>();
+			NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_scopes, m_errorReporter);
+			for (Source const* source: sourcesToAnalyse)
+				if (source->ast && !resolver.registerDeclarations(*source->ast))
+					return false;
+
+			map<string, SourceUnit const*> sourceUnitsByName;
+			for (auto& source: m_sources)
+				sourceUnitsByName[source.first] = source.second.ast.get();
+			for (Source const* source: sourcesToAnalyse)
+				if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
+					return false;
+
+			// This is the main name and type resolution loop. Needs to be run for every contract, because
+			// the special variables "this" and "super" must be set appropriately.
+			for (Source const* source: sourcesToAnalyse)
+				if (source->ast)
+					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 					{
-						// Note that we now reference contracts by their fully qualified names, and
-						// thus contracts can only conflict if declared in the same source file. This
-						// should already cause a double-declaration error elsewhere.
-						if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
-							m_contracts[contract->fullyQualifiedName()].contract = contract;
-						else
-							solAssert(
-								m_errorReporter.hasErrors(),
-								"Contract already present (name clash?), but no error was reported."
-							);
-					}
+						if (!resolver.resolveNamesAndTypes(*node))
+							return false;
+						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+						{
+							// Note that we now reference contracts by their fully qualified names, and
+							// thus contracts can only conflict if declared in the same source file. This
+							// should already cause a double-declaration error elsewhere.
+							if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
+								m_contracts[contract->fullyQualifiedName()].contract = contract;
+							else
+								solAssert(
+									m_errorReporter.hasErrors(),
+									"Contract already present (name clash?), but no error was reported."
+								);
+						}
 
-				}
+					}
+		}
 
-		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !declarationTypeChecker.check(*source->ast))
-				return false;
+		{
+			util::Profiler::Timer timer{"analysis.declarationTypes"};
+			DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
+			for (Source const* source: sourcesToAnalyse)
+				if (source->ast && !declarationTypeChecker.check(*source->ast))
+					return false;
+		}
 
 		// Next, we check inheritance, overrides, function collisions and other things at
 		// contract or function level.
 		// This also calculates whether a contract is abstract, which is needed by the
 		// type checker.
-		ContractLevelChecker contractLevelChecker(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast)
-				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-						if (!contractLevelChecker.check(*contract))
-							noErrors = false;
+		{
+			util::Profiler::Timer timer{"analysis.contractLevel"};
+			ContractLevelChecker contractLevelChecker(m_errorReporter);
+			for (Source const* source: sourcesToAnalyse)
+				if (source->ast)
+					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+							if (!contractLevelChecker.check(*contract))
+								noErrors = false;
+		}
 
 		// New we run full type checks that go down to the expression level. This
 		// cannot be done earlier, because we need cross-contract types and information
@@ -374,19 +412,23 @@ bool CompilerStack::analyze()
 		//
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
-		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast)
-				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-						if (!typeChecker.checkTypeRequirements(*contract))
-							noErrors = false;
+		{
+			util::Profiler::Timer timer{"analysis.typeChecking"};
+			TypeChecker typeChecker(m_evmVersion, m_errorReporter);
+			for (Source const* source: sourcesToAnalyse)
+				if (source->ast)
+					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+							if (!typeChecker.checkTypeRequirements(*contract))
+								noErrors = false;
+		}
 
 		if (noErrors)
 		{
+			util::Profiler::Timer timer{"analysis.postTypeChecking"};
 			// Checks that can only be done when all types of all AST nodes are known.
 			PostTypeChecker postTypeChecker(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast && !postTypeChecker.check(*source->ast))
 					noErrors = false;
 		}
@@ -394,25 +436,29 @@ bool CompilerStack::analyze()
 		// Check that immutable variables are never read in c'tors and assigned
 		// exactly once
 		if (noErrors)
-			for (Source const* source: m_sourceOrder)
+		{
+			util::Profiler::Timer timer{"analysis.immutables"};
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast)
 					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 							ImmutableValidator(m_errorReporter, *contract).analyze();
+		}
 
 		if (noErrors)
 		{
+			util::Profiler::Timer timer{"analysis.controlFlow"};
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
 			CFG cfg(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast && !cfg.constructFlow(*source->ast))
 					noErrors = false;
 
 			if (noErrors)
 			{
 				ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter);
-				for (Source const* source: m_sourceOrder)
+				for (Source const* source: sourcesToAnalyse)
 					if (source->ast && !controlFlowAnalyzer.analyze(*source->ast))
 						noErrors = false;
 			}
@@ -420,29 +466,50 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
+			util::Profiler::Timer timer{"analysis.staticAnalysis"};
 			// Checks for common mistakes. Only generates warnings.
 			StaticAnalyzer staticAnalyzer(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast && !staticAnalyzer.analyze(*source->ast))
 					noErrors = false;
 		}
 
 		if (noErrors)
 		{
+			util::Profiler::Timer timer{"analysis.viewPure"};
 			// Check for state mutability in every function.
+			// The checker needs the modifiers of all contracts, but the issues in reused
+			// sources were already reported by the previous compilation.
 			vector<ASTPointer<ASTNode>> ast;
 			for (Source const* source: m_sourceOrder)
 				if (source->ast)
 					ast.push_back(source->ast);
 
-			if (!ViewPureChecker(ast, m_errorReporter).check())
-				noErrors = false;
+			if (sourcesToAnalyse.size() == m_sourceOrder.size())
+			{
+				if (!ViewPureChecker(ast, m_errorReporter).check())
+					noErrors = false;
+			}
+			else
+			{
+				ErrorList viewPureErrors;
+				ErrorReporter viewPureErrorReporter(viewPureErrors);
+				ViewPureChecker(ast, viewPureErrorReporter).check();
+				for (auto const& error: viewPureErrors)
+					if (!isInReusedSource(*error))
+					{
+						m_errorReporter.append({error});
+						if (error->type() != Error::Type::Warning)
+							noErrors = false;
+					}
+			}
 		}
 
 		if (noErrors)
 		{
+			util::Profiler::Timer timer{"analysis.smtChecker"};
 			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses, m_readFile, m_enabledSMTSolvers);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast)
 					modelChecker.analyze(*source->ast);
 			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
@@ -501,22 +568,38 @@ bool CompilerStack::compile()
 		if (!parseAndAnalyze())
 			return false;
 
+	// Parsing can replace the type provider in incremental mode, so the scope is only
+	// entered afterwards.
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
+
 	if (m_hasError)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called compile with errors."));
 
 	// Only compile contracts individually which have been requested.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	// Contracts reused from the previous compilation in incremental mode are already compiled.
+	for (auto const& contract: m_contracts)
+		if (contract.second.compiler)
+			otherCompilers[contract.second.contract] = contract.second.compiler;
+	vector<ContractDefinition const*> compiledContracts;
+	if (m_shareYulFunctions)
+		m_yulFunctionMemo = make_shared<MultiUseYulFunctionMemo>(m_evmVersion, m_revertStrings);
+	// Code generation stays sequential even in parallel mode: It lazily fills caches in the
+	// AST, its annotations and the type provider, which are not synchronised.
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
 				{
-					compileContract(*contract, otherCompilers);
+					if (m_generateEvmBytecode)
+						compileContract(*contract, otherCompilers, compiledContracts);
 					if (m_generateIR || m_generateEwasm)
 						generateIR(*contract);
 					if (m_generateEwasm)
 						generateEwasm(*contract);
 				}
+	m_yulFunctionMemo.reset();
+	assembleContracts(compiledContracts);
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
@@ -640,7 +723,12 @@ string const& CompilerStack::yulIROptimized(string const& _contractName) const
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
-	return contract(_contractName).yulIROptimized;
+	Contract const& currentContract = contract(_contractName);
+	if (!currentContract.yulIROptimized)
+		currentContract.yulIROptimized = make_unique<string const>(
+			currentContract.yulIROptimizedObject ? printYulIROptimized(currentContract) : string{}
+		);
+	return *currentContract.yulIROptimized;
 }
 
 string const& CompilerStack::ewasm(string const& _contractName) const
@@ -728,6 +816,7 @@ Json::Value const& CompilerStack::contractABI(string const& _contractName) const
 
 Json::Value const& CompilerStack::contractABI(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
 
@@ -750,6 +839,7 @@ Json::Value const& CompilerStack::storageLayout(string const& _contractName) con
 
 Json::Value const& CompilerStack::storageLayout(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
 
@@ -772,6 +862,7 @@ Json::Value const& CompilerStack::natspecUser(string const& _contractName) const
 
 Json::Value const& CompilerStack::natspecUser(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
 
@@ -794,6 +885,7 @@ Json::Value const& CompilerStack::natspecDev(string const& _contractName) const
 
 Json::Value const& CompilerStack::natspecDev(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
 
@@ -808,6 +900,7 @@ Json::Value const& CompilerStack::natspecDev(Contract const& _contract) const
 
 Json::Value CompilerStack::methodIdentifiers(string const& _contractName) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
 
@@ -827,6 +920,7 @@ string const& CompilerStack::metadata(string const& _contractName) const
 
 string const& CompilerStack::metadata(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
 
@@ -870,6 +964,7 @@ size_t CompilerStack::functionEntryPoint(
 	FunctionDefinition const& _function
 ) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
@@ -920,6 +1015,275 @@ string const& CompilerStack::Source::ipfsUrl() const
 	return ipfsUrlCached;
 }
 
+void CompilerStack::parseInParallel(vector<string> _sourcesToParse)
+{
+	struct ParseResult
+	{
+		ErrorList errors;
+		unique_ptr<ErrorReporter> errorReporter;
+		unique_ptr<Parser> parser;
+		ASTPointer<SourceUnit> ast;
+	};
+
+	// Sources are parsed in waves: The sources imported by one wave form the next one.
+	// The results are merged in the order of the sequential parser, which processes
+	// sources in the same breadth-first order. Each source is parsed by its own parser,
+	// so its node IDs are shifted afterwards to match the ones of the sequential parser.
+	int64_t nodeIDOffset = m_lastNodeID;
+	while (!_sourcesToParse.empty())
+	{
+		vector<Source*> sources;
+		for (string const& path: _sourcesToParse)
+			sources.push_back(&m_sources[path]);
+		vector<ParseResult> results(sources.size());
+		util::parallelFor(sources.size(), m_parallelism, [&](size_t _index) {
+			TypeProvider::Scope typeProviderScope{*m_typeProvider};
+			ParseResult& result = results[_index];
+			result.errorReporter = make_unique<ErrorReporter>(result.errors);
+			result.parser = make_unique<Parser>(*result.errorReporter, m_evmVersion, m_parserErrorRecovery);
+			result.parser->enableNodeTracking();
+			sources[_index]->scanner->reset();
+			result.ast = result.parser->parse(sources[_index]->scanner);
+		});
+
+		vector<string> importedSources;
+		for (size_t i = 0; i < sources.size(); ++i)
+		{
+			if (m_errorReporter.appendWithinLimits(results[i].errors))
+			{
+				results[i].parser->shiftNodeIDs(nodeIDOffset);
+				nodeIDOffset += results[i].parser->lastNodeID();
+				sources[i]->ast = results[i].ast;
+			}
+			else
+			{
+				// The limits on the number of errors and warnings apply to all sources together,
+				// so this source is parsed again with the error reporter of the compiler stack,
+				// like the sequential parser does.
+				Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+				parser.continueNodeIDsAfter(nodeIDOffset);
+				sources[i]->scanner->reset();
+				sources[i]->ast = parser.parse(sources[i]->scanner);
+				nodeIDOffset = parser.lastNodeID();
+			}
+			if (!sources[i]->ast)
+				solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
+			else
+				addImportedSources(_sourcesToParse[i], importedSources);
+		}
+		_sourcesToParse = move(importedSources);
+	}
+	m_lastNodeID = nodeIDOffset;
+}
+
+void CompilerStack::addImportedSources(string const& _path, vector<string>& _sourcesToParse)
+{
+	Source& source = m_sources[_path];
+	source.ast->annotation().path = _path;
+	for (auto const& newSource: loadMissingSources(*source.ast, _path))
+	{
+		string const& newPath = newSource.first;
+		string const& newContents = newSource.second;
+		m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
+		_sourcesToParse.push_back(newPath);
+	}
+}
+
+namespace
+{
+/// Collects the nodes of an AST.
+class NodeCollector: public ASTConstVisitor
+{
+public:
+	explicit NodeCollector(set<ASTNode const*>& _nodes): m_nodes(_nodes) {}
+
+private:
+	bool visitNode(ASTNode const& _node) override
+	{
+		m_nodes.insert(&_node);
+		return true;
+	}
+
+	set<ASTNode const*>& m_nodes;
+};
+}
+
+void CompilerStack::storeIncrementalState()
+{
+	auto state = make_unique<IncrementalState>();
+	// The types of discarded sources that do not refer to their nodes cannot be removed, so the
+	// type provider grows with every reuse. It is replaced once it doubled in size.
+	state->typeCountLimit = m_typeCountLimit ? m_typeCountLimit : 2 * m_typeProvider->typeCount();
+	state->typeProvider = move(m_typeProvider);
+	state->globalContext = move(m_globalContext);
+	for (Source const* source: m_sourceOrder)
+		state->analysedSources.insert(source->ast->annotation().path);
+	state->sources = move(m_sources);
+	state->scopes = move(m_scopes);
+	state->contracts = move(m_contracts);
+	// The YulStrings of the IR objects might not survive until the next compilation.
+	for (auto& contract: state->contracts)
+		if (contract.second.yulIROptimizedObject)
+		{
+			if (!contract.second.yulIROptimized)
+				contract.second.yulIROptimized = make_unique<string const>(printYulIROptimized(contract.second));
+			contract.second.yulIROptimizedObject.reset();
+		}
+	state->errors = m_errorReporter.errors();
+	state->lastNodeID = m_lastNodeID;
+	state->optimiserSettings = m_optimiserSettings;
+	state->revertStrings = m_revertStrings;
+	state->evmVersion = m_evmVersion;
+	state->enabledSMTSolvers = m_enabledSMTSolvers;
+	state->generateIR = m_generateIR;
+	state->generateEwasm = m_generateEwasm;
+	state->generateEvmBytecode = m_generateEvmBytecode;
+	state->libraries = m_libraries;
+	state->remappings = m_remappings;
+	state->metadataLiteralSources = m_metadataLiteralSources;
+	state->metadataHash = m_metadataHash;
+	state->parserErrorRecovery = m_parserErrorRecovery;
+	m_incrementalState = move(state);
+}
+
+bool CompilerStack::settingsMatch(IncrementalState const& _state) const
+{
+	auto remappingsMatch = [](Remapping const& _a, Remapping const& _b)
+	{
+		return _a.context == _b.context && _a.prefix == _b.prefix && _a.target == _b.target;
+	};
+	return
+		_state.optimiserSettings == m_optimiserSettings &&
+		_state.revertStrings == m_revertStrings &&
+		_state.evmVersion == m_evmVersion &&
+		_state.enabledSMTSolvers.cvc4 == m_enabledSMTSolvers.cvc4 &&
+		_state.enabledSMTSolvers.z3 == m_enabledSMTSolvers.z3 &&
+		_state.generateIR == m_generateIR &&
+		_state.generateEwasm == m_generateEwasm &&
+		_state.generateEvmBytecode == m_generateEvmBytecode &&
+		_state.libraries == m_libraries &&
+		equal(_state.remappings.begin(), _state.remappings.end(), m_remappings.begin(), m_remappings.end(), remappingsMatch) &&
+		_state.metadataLiteralSources == m_metadataLiteralSources &&
+		_state.metadataHash == m_metadataHash &&
+		_state.parserErrorRecovery == m_parserErrorRecovery;
+}
+
+vector<string> CompilerStack::reuseAnalysedSources()
+{
+	unique_ptr<IncrementalState> state = move(m_incrementalState);
+	vector<string> sourcesToParse;
+	vector<string> paths;
+	for (auto const& source: m_sources)
+		paths.push_back(source.first);
+	if (!state || !settingsMatch(*state) || state->typeProvider->typeCount() > state->typeCountLimit)
+		return paths;
+
+	// Take over the analysed sources whose content is unchanged and
+	// load the sources they import.
+	set<string> reusedSources;
+	for (size_t i = 0; i < paths.size(); ++i)
+	{
+		string const path = paths[i];
+		auto previous = state->sources.find(path);
+		if (
+			!state->analysedSources.count(path) ||
+			previous->second.scanner->source() != m_sources[path].scanner->source()
+		)
+		{
+			sourcesToParse.push_back(path);
+			continue;
+		}
+		m_sources[path] = previous->second;
+		m_sources[path].reused = false;
+		reusedSources.insert(path);
+		for (auto const& node: previous->second.ast->nodes())
+			if (auto const* import = dynamic_cast<ImportDirective const*>(node.get()))
+			{
+				string const& importPath = import->annotation().absolutePath;
+				if (m_sources.count(importPath) || !m_readFile)
+					continue;
+				ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
+				// Sources that cannot be read are reported when parsing the importing source.
+				if (result.success)
+				{
+					m_sources[importPath].scanner = make_shared<Scanner>(CharStream(result.responseOrErrorMessage, importPath));
+					paths.push_back(importPath);
+				}
+			}
+	}
+
+	// A source can only be reused if the sources it imports are reused as well.
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (auto it = reusedSources.begin(); it != reusedSources.end();)
+		{
+			bool importsReused = true;
+			for (auto const& node: m_sources[*it].ast->nodes())
+				if (auto const* import = dynamic_cast<ImportDirective const*>(node.get()))
+					if (!reusedSources.count(import->annotation().absolutePath))
+						importsReused = false;
+			if (importsReused)
+				++it;
+			else
+			{
+				m_sources[*it].ast = nullptr;
+				sourcesToParse.push_back(*it);
+				it = reusedSources.erase(it);
+				changed = true;
+			}
+		}
+	}
+	if (reusedSources.empty())
+		return sourcesToParse;
+
+	set<ASTNode const*> reusedNodes;
+	NodeCollector nodeCollector(reusedNodes);
+	for (string const& path: reusedSources)
+	{
+		m_sources[path].reused = true;
+		m_sources[path].ast->accept(nodeCollector);
+	}
+
+	// The types, scopes and global declarations of the reused sources are referenced
+	// from their annotations, so they are taken over as well. The types referring to
+	// the discarded sources and the cached members, which can refer to any declaration,
+	// are removed, since new nodes can be allocated at the addresses of discarded ones.
+	set<ASTNode const*> discardedNodes;
+	NodeCollector discardedNodeCollector(discardedNodes);
+	for (auto const& source: state->sources)
+		if (source.second.ast && !reusedSources.count(source.first))
+			source.second.ast->accept(discardedNodeCollector);
+	state->typeProvider->discardTypesReferringTo(discardedNodes);
+	m_typeProvider = move(state->typeProvider);
+	m_typeCountLimit = state->typeCountLimit;
+	m_globalContext = move(state->globalContext);
+	set<ContractDefinition const*> reusedContracts;
+	for (auto& contract: state->contracts)
+		if (reusedSources.count(contract.second.contract->sourceUnitName()))
+		{
+			reusedContracts.insert(contract.second.contract);
+			m_contracts[contract.first] = move(contract.second);
+		}
+	m_globalContext->retainContracts(reusedContracts);
+	for (auto& scope: state->scopes)
+		if (!scope.first || reusedNodes.count(scope.first))
+			m_scopes[scope.first] = move(scope.second);
+	for (auto const& error: state->errors)
+		if (isInReusedSource(*error))
+			m_errorReporter.append({error});
+	m_lastNodeID = state->lastNodeID;
+	return sourcesToParse;
+}
+
+bool CompilerStack::isInReusedSource(Error const& _error) const
+{
+	if (SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(_error))
+		if (location->source && m_sources.count(location->source->name()))
+			return m_sources.at(location->source->name()).reused;
+	return false;
+}
+
 StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string const& _sourcePath)
 {
 	solAssert(m_stackState < ParsingPerformed, "");
@@ -1050,7 +1414,8 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
-	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers,
+	vector<ContractDefinition const*>& _compiledContracts
 )
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
@@ -1060,22 +1425,116 @@ void CompilerStack::compileContract(
 	if (_otherCompilers.count(&_contract) || !_contract.canBeDeployed())
 		return;
 	for (auto const* dependency: _contract.annotation().contractDependencies)
-		compileContract(*dependency, _otherCompilers);
+		compileContract(*dependency, _otherCompilers, _compiledContracts);
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
 	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
 	compiledContract.compiler = compiler;
+	compiler->setYulFunctionMemo(m_yulFunctionMemo);
 
 	bytes cborEncodedMetadata = createCBORMetadata(
 		metadata(compiledContract),
 		!onlySafeExperimentalFeaturesActivated(_contract.sourceUnit().annotation().experimentalFeatures)
 	);
 
+	// Code generation only refers to the assemblies of other contracts, it does not
+	// depend on their contents, so optimisation and assembly can be deferred.
+	{
+		util::Profiler::Timer timer{"codegen"};
+		compiler->generateCode(_contract, _otherCompilers, cborEncodedMetadata);
+	}
+
+	_otherCompilers[compiledContract.contract] = compiler;
+	_compiledContracts.push_back(&_contract);
+}
+
+void CompilerStack::assembleContracts(vector<ContractDefinition const*> const& _contracts)
+{
+	vector<Contract*> contracts;
+	for (auto const* contract: _contracts)
+		contracts.push_back(&m_contracts.at(contract->fullyQualifiedName()));
+
+	if (m_parallelism <= 1 || contracts.size() <= 1)
+		for (Contract* contract: contracts)
+			assembleContract(*contract, m_parallelism);
+	else
+	{
+		// Assemblies of contracts created via "new" are shared as sub-assemblies and they are
+		// modified and cached during optimisation and assembly. Contracts that reach a common
+		// assembly are thus grouped and each group is processed by a single thread in the
+		// original order. This results in exactly the same output as the sequential mode.
+		vector<size_t> groupOf(contracts.size());
+		function<size_t(size_t)> findGroup = [&](size_t _index) -> size_t
+		{
+			if (groupOf[_index] != _index)
+				groupOf[_index] = findGroup(groupOf[_index]);
+			return groupOf[_index];
+		};
+		map<evmasm::Assembly const*, size_t> assemblyOwners;
+		for (size_t i = 0; i < contracts.size(); ++i)
+		{
+			groupOf[i] = i;
+			vector<evmasm::Assembly const*> toVisit{&contracts[i]->compiler->assembly()};
+			while (!toVisit.empty())
+			{
+				evmasm::Assembly const* assembly = toVisit.back();
+				toVisit.pop_back();
+				auto [owner, inserted] = assemblyOwners.emplace(assembly, i);
+				if (!inserted)
+				{
+					groupOf[findGroup(owner->second)] = findGroup(i);
+					continue;
+				}
+				for (size_t subId = 0; subId < assembly->numSubs(); ++subId)
+					toVisit.push_back(&assembly->sub(subId));
+			}
+		}
+
+		vector<vector<Contract*>> groups;
+		map<size_t, size_t> groupIndices;
+		for (size_t i = 0; i < contracts.size(); ++i)
+		{
+			auto [groupIndex, inserted] = groupIndices.emplace(findGroup(i), groups.size());
+			if (inserted)
+				groups.emplace_back();
+			groups[groupIndex->second].push_back(contracts[i]);
+		}
+
+		size_t threadsPerGroup = max<size_t>(1, m_parallelism / groups.size());
+		util::parallelFor(groups.size(), m_parallelism, [&](size_t _groupIndex) {
+			TypeProvider::Scope typeProviderScope{*m_typeProvider};
+			for (Contract* contract: groups[_groupIndex])
+				assembleContract(*contract, threadsPerGroup);
+		});
+	}
+
+	// Throw a warning if EIP-170 limits are exceeded:
+	//   If contract creation initialization returns data with length of more than 0x6000 (214 + 213) bytes,
+	//   contract creation fails with an out of gas error.
+	for (Contract const* contract: contracts)
+		if (
+			m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
+			contract->runtimeObject.bytecode.size() > 0x6000
+		)
+			m_errorReporter.warning(
+				contract->contract->location(),
+				"Contract code size exceeds 24576 bytes (a limit introduced in Spurious Dragon). "
+				"This contract may not be deployable on mainnet. "
+				"Consider enabling the optimizer (with a low \"runs\" value!), "
+				"turning off revert strings, or using libraries."
+			);
+}
+
+void CompilerStack::assembleContract(Contract& _contract, size_t _maxThreads)
+{
+	solAssert(_contract.compiler, "");
+
 	try
 	{
-		// Run optimiser and compile the contract.
-		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
+		// Run optimiser.
+		util::Profiler::Timer timer{"evmasm.optimiser"};
+		_contract.compiler->optimise(_maxThreads);
 	}
 	catch(evmasm::OptimizerException const&)
 	{
@@ -1085,7 +1544,8 @@ void CompilerStack::compileContract(
 	try
 	{
 		// Assemble deployment (incl. runtime)  object.
-		compiledContract.object = compiler->assembledObject();
+		util::Profiler::Timer timer{"evmasm.assembly"};
+		_contract.object = _contract.compiler->assembledObject();
 	}
 	catch(evmasm::AssemblyException const&)
 	{
@@ -1095,29 +1555,13 @@ void CompilerStack::compileContract(
 	try
 	{
 		// Assemble runtime object.
-		compiledContract.runtimeObject = compiler->runtimeObject();
+		util::Profiler::Timer timer{"evmasm.assembly"};
+		_contract.runtimeObject = _contract.compiler->runtimeObject();
 	}
 	catch(evmasm::AssemblyException const&)
 	{
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
-
-	// Throw a warning if EIP-170 limits are exceeded:
-	//   If contract creation initialization returns data with length of more than 0x6000 (214 + 213) bytes,
-	//   contract creation fails with an out of gas error.
-	if (
-		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
-		compiledContract.runtimeObject.bytecode.size() > 0x6000
-	)
-		m_errorReporter.warning(
-			_contract.location(),
-			"Contract code size exceeds 24576 bytes (a limit introduced in Spurious Dragon). "
-			"This contract may not be deployable on mainnet. "
-			"Consider enabling the optimizer (with a low \"runs\" value!), "
-			"turning off revert strings, or using libraries."
-		);
-
-	_otherCompilers[compiledContract.contract] = compiler;
 }
 
 void CompilerStack::generateIR(ContractDefinition const& _contract)
@@ -1136,8 +1580,10 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	for (auto const* dependency: _contract.annotation().contractDependencies)
 		generateIR(*dependency);
 
+	util::Profiler::Timer timer{"irGeneration"};
 	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract);
+	generator.setYulFunctionMemo(m_yulFunctionMemo);
+	tie(compiledContract.yulIR, compiledContract.yulIROptimizedObject) = generator.run(_contract);
 }
 
 void CompilerStack::generateEwasm(ContractDefinition const& _contract)
@@ -1147,13 +1593,16 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called generateEwasm with errors."));
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
 	if (!compiledContract.ewasm.empty())
 		return;
+	solAssert(compiledContract.yulIROptimizedObject, "");
 
-	// Re-parse the Yul IR in EVM dialect
+	util::Profiler::Timer timer{"ewasm"};
+	// The translation modifies the object, so the optimized IR has to be printed first.
+	if (!compiledContract.yulIROptimized)
+		compiledContract.yulIROptimized = make_unique<string const>(printYulIROptimized(compiledContract));
 	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	stack.loadAnalyzed(move(compiledContract.yulIROptimizedObject));
 
 	stack.optimize();
 	stack.translate(yul::AssemblyStack::Language::Ewasm);
@@ -1167,6 +1616,14 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 	compiledContract.ewasmObject = std::move(*result.bytecode);
 }
 
+string CompilerStack::printYulIROptimized(Contract const& _contract) const
+{
+	solAssert(_contract.yulIROptimizedObject, "");
+	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
+	stack.loadAnalyzed(_contract.yulIROptimizedObject);
+	return IRGenerator::warning + stack.print();
+}
+
 CompilerStack::Contract const& CompilerStack::contract(string const& _contractName) const
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
@@ -1259,6 +1716,8 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 		details["peephole"] = m_optimiserSettings.runPeephole;
 		details["deduplicate"] = m_optimiserSettings.runDeduplicate;
 		details["cse"] = m_optimiserSettings.runCSE;
+		if (m_optimiserSettings.runCSE && m_optimiserSettings.runCSEAcrossBlocks)
+			details["cseAcrossBlocks"] = true;
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
 		if (m_optimiserSettings.runYulOptimiser)
@@ -1419,6 +1878,7 @@ Json::Value gasToJson(GasEstimator::GasConsumption const& _gas)
 
 Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
@@ -35,6 +35,8 @@
 
 #include <libevmasm/LinkerObject.h>
 
+#include <libyul/YulString.h>
+
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
 
@@ -54,6 +56,11 @@ class Scanner;
 }
 
 
+namespace solidity::yul
+{
+struct Object;
+}
+
 namespace solidity::evmasm
 {
 class Assembly;
@@ -68,9 +75,11 @@ namespace solidity::frontend
 class ASTNode;
 class ContractDefinition;
 class FunctionDefinition;
+class MultiUseYulFunctionMemo;
 class SourceUnit;
 class Compiler;
 class GlobalContext;
+class TypeProvider;
 class Natspec;
 class DeclarationContainer;
 
@@ -173,9 +182,31 @@ public:
 		m_requestedContractNames = _contractNames;
 	}
 
+	/// Sets the maximum number of threads used to parse the sources and to optimise and
+	/// assemble the generated code of the contracts. Code generation is sequential.
+	/// Values larger than one enable the parallel mode, which produces the same output as the
+	/// sequential one.
+	/// Must be set before parsing.
+	void setParallelism(unsigned _jobs);
+
+	/// Enables incremental compilation: After a compilation without errors, reset() with
+	/// @a _keepSettings set keeps the analysed sources. If the settings are not changed, the next
+	/// compilation neither parses nor analyses the sources whose content and transitive imports
+	/// are unchanged, and reuses the code generated for their contracts.
+	void enableIncrementalCompilation(bool _enable = true) { m_incremental = _enable; }
+
 	/// Enable experimental generation of Yul IR code.
 	void enableIRGeneration(bool _enable = true) { m_generateIR = _enable; }
 
+	/// Enables the generation of EVM bytecode by the legacy code generator, which is the default.
+	/// Only meant for benchmarks, which disable it to measure the IR generation alone.
+	/// Without it, the bytecode, assembly and gas estimation outputs are not available.
+	void enableEvmBytecodeGeneration(bool _enable = true) { m_generateEvmBytecode = _enable; }
+
+	/// Enables sharing the generated Yul utility functions between all contracts of a
+	/// compilation, which is the default. The output does not depend on it.
+	void enableYulFunctionSharing(bool _enable = true) { m_shareYulFunctions = _enable; }
+
 	/// Enable experimental generation of Ewasm code. If enabled, IR is also generated.
 	void enableEwasmGeneration(bool _enable = true) { m_generateEwasm = _enable; }
 
@@ -325,6 +356,8 @@ private:
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
+		/// True if the AST and its analysis were taken over from the previous compilation.
+		bool reused = false;
 		void reset() { *this = Source(); }
 		util::h256 const& keccak256() const;
 		util::h256 const& swarmHash() const;
@@ -339,7 +372,8 @@ private:
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Experimental Yul IR code.
-		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
+		std::shared_ptr<yul::Object> yulIROptimizedObject; ///< Optimized experimental Yul IR object.
+		mutable std::unique_ptr<std::string const> yulIROptimized; ///< Optimized experimental Yul IR code, printed on demand.
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
 		mutable std::unique_ptr<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -351,6 +385,53 @@ private:
 		mutable std::unique_ptr<std::string const> runtimeSourceMapping;
 	};
 
+	/// The analysed sources, the code of their contracts and the settings of a compilation
+	/// without errors, kept by reset() for incremental compilation.
+	struct IncrementalState
+	{
+		std::unique_ptr<TypeProvider> typeProvider;
+		/// The number of types above which the type provider is not reused anymore.
+		size_t typeCountLimit = 0;
+		std::shared_ptr<GlobalContext> globalContext;
+		std::map<std::string const, Source> sources;
+		std::set<std::string> analysedSources;
+		std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>> scopes;
+		std::map<std::string const, Contract> contracts;
+		langutil::ErrorList errors;
+		int64_t lastNodeID = 0;
+		OptimiserSettings optimiserSettings;
+		RevertStrings revertStrings;
+		langutil::EVMVersion evmVersion;
+		smt::SMTSolverChoice enabledSMTSolvers;
+		bool generateIR;
+		bool generateEwasm;
+		bool generateEvmBytecode;
+		std::map<std::string, util::h160> libraries;
+		std::vector<Remapping> remappings;
+		bool metadataLiteralSources;
+		MetadataHash metadataHash;
+		bool parserErrorRecovery;
+	};
+
+	/// Moves the analysed sources and the settings of the current compilation into m_incrementalState.
+	void storeIncrementalState();
+	/// @returns true if the settings of the compilation stored in @a _state equal the current ones.
+	bool settingsMatch(IncrementalState const& _state) const;
+	/// Takes over the sources from m_incrementalState whose content and transitive imports are
+	/// unchanged, together with their scopes, contracts and warnings, and loads the sources
+	/// they import. Discards m_incrementalState afterwards.
+	/// @returns the names of the sources that have to be parsed.
+	std::vector<std::string> reuseAnalysedSources();
+	/// @returns true if @a _error is located in a source reused from the previous compilation.
+	bool isInReusedSource(langutil::Error const& _error) const;
+
+	/// Parses the given sources and all sources they import, using multiple threads.
+	/// The resulting ASTs, node IDs and errors are the same as for sequential parsing.
+	void parseInParallel(std::vector<std::string> _sourcesToParse);
+	/// Annotates the parsed source @a _path with its path, loads the sources imported
+	/// by it and appends the newly loaded ones to @a _sourcesToParse.
+	void addImportedSources(std::string const& _path, std::vector<std::string>& _sourcesToParse);
+
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
 	/// @a m_readFile and stores the absolute paths of all imports in the AST annotations.
 	/// @returns the newly loaded sources.
@@ -364,14 +445,26 @@ private:
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
-	/// Compile a single contract.
+	/// Generate the code for a single contract and the contracts it depends on.
+	/// The assembly optimiser is not run, this is done by assembleContracts.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
+	/// @param _compiledContracts the contracts whose code was generated, in generation order.
 	void compileContract(
 		ContractDefinition const& _contract,
-		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers,
+		std::vector<ContractDefinition const*>& _compiledContracts
 	);
 
+	/// Optimises and assembles the previously generated code of the given contracts.
+	/// If parallelism is enabled, contracts that do not share sub-assemblies are processed
+	/// concurrently.
+	void assembleContracts(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// Optimises and assembles the previously generated code of a single contract, using up to
+	/// @a _maxThreads threads for its independent sub-assemblies.
+	void assembleContract(Contract& _contract, size_t _maxThreads);
+
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
@@ -383,6 +476,9 @@ private:
 	/// library will still be kept as an unlinked placeholder in the objects.
 	void link();
 
+	/// @returns the text representation of the optimized IR object of @a _contract.
+	std::string printYulIROptimized(Contract const& _contract) const;
+
 	/// @returns the contract object for the given @a _contractName.
 	/// Can only be called after state is CompilationSuccessful.
 	Contract const& contract(std::string const& _contractName) const;
@@ -428,14 +524,22 @@ private:
 		FunctionDefinition const& _function
 	) const;
 
+	/// Defers resets of the Yul string repository while this compiler stack may hold
+	/// YulStrings, e.g. in its IR objects. Declared first, so that it is destroyed last.
+	yul::YulStringRepository::Scope m_yulStringScope;
+	/// Owns the types of this compilation. Destroyed after all other members but the scope.
+	std::unique_ptr<TypeProvider> m_typeProvider;
 	ReadCallback::Callback m_readFile;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	langutil::EVMVersion m_evmVersion;
 	smt::SMTSolverChoice m_enabledSMTSolvers;
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
+	unsigned m_parallelism = 1;
 	bool m_generateIR;
 	bool m_generateEwasm;
+	bool m_generateEvmBytecode = true;
+	bool m_shareYulFunctions = true;
 	std::map<std::string, util::h160> m_libraries;
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
@@ -457,6 +561,16 @@ private:
 	bool m_parserErrorRecovery = false;
 	State m_stackState = Empty;
 	bool m_importedSources = false;
+	bool m_incremental = false;
+	/// Present between reset() and parse() in incremental mode.
+	std::unique_ptr<IncrementalState> m_incrementalState;
+	/// The number of types above which m_typeProvider is not reused anymore, zero if it
+	/// was not reused yet.
+	size_t m_typeCountLimit = 0;
+	/// The ID of the last AST node created by parsing.
+	int64_t m_lastNodeID = 0;
+	/// Yul utility functions shared between the contracts during compile().
+	std::shared_ptr<MultiUseYulFunctionMemo> m_yulFunctionMemo;
 	/// Whether or not there has been an error during processing.
 	/// If this is true, the stack will refuse to generate code.
 	bool m_hasError = false;
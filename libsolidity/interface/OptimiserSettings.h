@@ -71,6 +71,7 @@ struct OptimiserSettings
 			runPeephole == _other.runPeephole &&
 			runDeduplicate == _other.runDeduplicate &&
 			runCSE == _other.runCSE &&
+			runCSEAcrossBlocks == _other.runCSEAcrossBlocks &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
@@ -88,6 +89,9 @@ struct OptimiserSettings
 	bool runDeduplicate = false;
 	/// Common subexpression eliminator based on assembly items.
 	bool runCSE = false;
+	/// Seed the common subexpression eliminator with knowledge about storage and memory
+	/// gathered along the control flow graph. Only effective together with runCSE.
+	bool runCSEAcrossBlocks = false;
 	/// Constant optimizer, which tries to find better representations that satisfy the given
 	/// size/cost-trade-off.
 	bool runConstantOptimiser = false;
@@ -21,6 +21,7 @@
  */
 
 #include <libsolidity/interface/StandardCompiler.h>
+#include <libsolidity/interface/Version.h>
 
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libyul/AssemblyStack.h>
@@ -29,6 +30,7 @@
 #include <libevmasm/Instruction.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/Profiler.h>
 
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/algorithm/string.hpp>
@@ -76,6 +78,18 @@ Json::Value formatFatalError(string const& _type, string const& _message)
 	return output;
 }
 
+/// @returns the recorded phases with their number of calls and their total time in microseconds.
+Json::Value formatProfile(util::Profiler const& _profiler)
+{
+	Json::Value profile = Json::objectValue;
+	for (auto const& [phase, entry]: _profiler.entries())
+	{
+		profile[phase]["calls"] = Json::UInt64(entry.calls);
+		profile[phase]["microseconds"] = Json::Int64(chrono::duration_cast<chrono::microseconds>(entry.time).count());
+	}
+	return profile;
+}
+
 Json::Value formatSourceLocation(SourceLocation const* location)
 {
 	Json::Value sourceLocation;
@@ -375,7 +389,7 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "remappings"};
+	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "parallelism", "profiling", "remappings"};
 	return checkKeys(_input, keys, "settings");
 }
 
@@ -387,7 +401,7 @@ std::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkOptimizerDetailsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"peephole", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails"};
+	static set<string> keys{"peephole", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "cseAcrossBlocks", "constantOptimizer", "yul", "yulDetails"};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -501,6 +515,8 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "cse", settings.runCSE))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "cseAcrossBlocks", settings.runCSEAcrossBlocks))
+			return *error;
 		if (auto error = checkOptimizerDetail(details, "constantOptimizer", settings.runConstantOptimiser))
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "yul", settings.runYulOptimiser))
@@ -774,6 +790,20 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 				CompilerStack::MetadataHash::None;
 	}
 
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt() || settings["parallelism"].asUInt() == 0)
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be a positive integer.");
+		ret.parallelism = settings["parallelism"].asUInt();
+	}
+
+	if (settings.isMember("profiling"))
+	{
+		if (!settings["profiling"].isBool())
+			return formatFatalError("JSONError", "\"settings.profiling\" must be a Boolean.");
+		ret.profiling = settings["profiling"].asBool();
+	}
+
 	Json::Value outputSelection = settings.get("outputSelection", Json::Value());
 
 	if (auto jsonError = checkOutputSelection(outputSelection))
@@ -781,12 +811,77 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 
 	ret.outputSelection = std::move(outputSelection);
 
+	ret.cacheKeyInput["settings"] = settings;
+	ret.cacheKeyInput["settings"].removeMember("parallelism");
+	ret.cacheKeyInput["settings"].removeMember("profiling");
+	ret.cacheKeyInput["auxiliaryInput"] = _input["auxiliaryInput"];
+
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+Json::Value StandardCompiler::compileSolidityCached(StandardCompiler::InputsAndSettings _inputsAndSettings)
+{
+	solAssert(m_cache, "");
+
+	Json::Value keyInput = std::move(_inputsAndSettings.cacheKeyInput);
+	keyInput["compiler"] = VersionString;
+	keyInput["sources"] = Json::objectValue;
+	for (auto const& [name, content]: _inputsAndSettings.sources)
+		keyInput["sources"][name] = util::keccak256(content).hex();
+	util::h256 const key = util::keccak256(util::jsonCompactPrint(keyInput));
+
+	auto const readFileKind = ReadCallback::kindString(ReadCallback::Kind::ReadFile);
+	if (optional<ArtifactCache::Entry> entry = m_cache->load(key))
+	{
+		bool unchanged = true;
+		for (auto const& [path, hash]: entry->loadedFiles)
+		{
+			ReadCallback::Result result{false, ""};
+			if (m_readFile)
+				result = m_readFile(readFileKind, path);
+			if (!result.success || util::keccak256(result.responseOrErrorMessage) != hash)
+			{
+				unchanged = false;
+				break;
+			}
+		}
+		if (unchanged)
+			return std::move(entry->output);
+	}
+
+	// Record the files loaded during compilation. Results that depend on other
+	// callback requests are not stored.
+	ArtifactCache::Entry entry;
+	bool cacheable = true;
+	ReadCallback::Callback readFile;
+	if (m_readFile)
+		readFile = [&](string const& _kind, string const& _path)
+		{
+			ReadCallback::Result result = m_readFile(_kind, _path);
+			if (_kind == readFileKind && result.success)
+				entry.loadedFiles[_path] = util::keccak256(result.responseOrErrorMessage);
+			else
+				cacheable = false;
+			return result;
+		};
+
+	entry.output = compileSolidity(std::move(_inputsAndSettings), readFile);
+	Json::Value const& output = entry.output;
+	if (output.isMember("errors"))
+		for (auto const& error: output["errors"])
+			if (error["severity"] != "warning")
+				cacheable = false;
+	if (cacheable)
+		m_cache->store(key, entry);
+	return std::move(entry.output);
+}
+
+Json::Value StandardCompiler::compileSolidity(
+	StandardCompiler::InputsAndSettings _inputsAndSettings,
+	ReadCallback::Callback const& _readFile
+)
 {
-	CompilerStack compilerStack(m_readFile);
+	CompilerStack compilerStack(_readFile);
 
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
 	compilerStack.setSources(sourceList);
@@ -800,6 +895,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.setLibraries(_inputsAndSettings.libraries);
 	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
 	compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
 	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
 
 	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
@@ -1120,7 +1216,11 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	if (YulStringRepository::instance().size() > MaxYulStrings)
+		YulStringRepository::reset();
+	// Defers resets requested by compilations running concurrently in other threads
+	// until this compilation is finished.
+	YulStringRepository::Scope yulStringScope;
 
 	try
 	{
@@ -1128,12 +1228,25 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 		if (parsed.type() == typeid(Json::Value))
 			return boost::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = boost::get<InputsAndSettings>(std::move(parsed));
-		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
-		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
-		else
+		if (settings.language != "Solidity" && settings.language != "Yul")
 			return formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language.");
+
+		util::Profiler profiler;
+		bool const profiling = settings.profiling;
+		Json::Value output;
+		{
+			util::Profiler::Scope profilerScope{profiling ? &profiler : util::Profiler::current()};
+			if (settings.language == "Yul")
+				output = compileYul(std::move(settings));
+			// Profiled compilations are not served from the cache, as the profile would be meaningless.
+			else if (m_cache && !profiling)
+				output = compileSolidityCached(std::move(settings));
+			else
+				output = compileSolidity(std::move(settings), m_readFile);
+		}
+		if (profiling)
+			output["profiling"] = formatProfile(profiler);
+		return output;
 	}
 	catch (Json::LogicError const& _exception)
 	{
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <libsolidity/interface/ArtifactCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 
 #include <boost/variant.hpp>
@@ -41,11 +42,22 @@ public:
 	/// Creates a new StandardCompiler.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
-	explicit StandardCompiler(ReadCallback::Callback _readFile = ReadCallback::Callback()):
-		m_readFile(std::move(_readFile))
+	/// @param _cache if given, the results of Solidity compilations are looked up in and
+	/// stored to this cache.
+	explicit StandardCompiler(
+		ReadCallback::Callback _readFile = ReadCallback::Callback(),
+		std::shared_ptr<ArtifactCache const> _cache = nullptr
+	):
+		m_readFile(std::move(_readFile)),
+		m_cache(std::move(_cache))
 	{
 	}
 
+	/// Number of strings in the YulString repository above which it is reset before a
+	/// compilation. Up to this size, the strings and the caches that refer to them are
+	/// kept across compilations.
+	static size_t constexpr MaxYulStrings = 1 << 18;
+
 	/// Sets all input parameters according to @a _input which conforms to the standardized input
 	/// format, performs compilation and returns a standardized output.
 	Json::Value compile(Json::Value const& _input) noexcept;
@@ -68,17 +80,26 @@ private:
 		std::map<std::string, util::h160> libraries;
 		bool metadataLiteralSources = false;
 		CompilerStack::MetadataHash metadataHash = CompilerStack::MetadataHash::IPFS;
+		unsigned parallelism = 1;
+		bool profiling = false;
 		Json::Value outputSelection;
+		/// The parts of the input apart from the sources that influence the output.
+		/// Used to compute the cache key.
+		Json::Value cacheKeyInput;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	boost::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Compiles Solidity sources, loading imports with @a _readFile.
+	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings, ReadCallback::Callback const& _readFile);
+	/// Serves the compilation from the cache or compiles and stores the result in the cache.
+	Json::Value compileSolidityCached(InputsAndSettings _inputsAndSettings);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	std::shared_ptr<ArtifactCache const> m_cache;
 };
 
 }
@@ -61,7 +61,7 @@ public:
 		solAssert(m_location.source, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		return m_parser.trackNode(m_parser.create<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...));
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -71,6 +71,13 @@ private:
 	SourceLocation m_location;
 };
 
+void Parser::shiftNodeIDs(int64_t _offset)
+{
+	for (auto const& node: m_trackedNodes)
+		node->shiftID(_offset);
+	m_trackedNodes.clear();
+}
+
 ASTPointer<SourceUnit> Parser::parse(shared_ptr<Scanner> const& _scanner)
 {
 	solAssert(!m_insideModifier, "");
@@ -78,6 +85,7 @@ ASTPointer<SourceUnit> Parser::parse(shared_ptr<Scanner> const& _scanner)
 	{
 		m_recursionDepth = 0;
 		m_scanner = _scanner;
+		m_arena = make_shared<util::Arena>();
 		ASTNodeFactory nodeFactory(*this);
 		vector<ASTPointer<ASTNode>> nodes;
 		while (m_scanner->currentToken() != Token::EOS)
@@ -142,7 +150,7 @@ ASTPointer<StructuredDocumentation> Parser::parseStructuredDocumentation()
 		ASTNodeFactory nodeFactory{*this};
 		nodeFactory.setLocation(m_scanner->currentCommentLocation());
 		return nodeFactory.createNode<StructuredDocumentation>(
-			make_shared<ASTString>(m_scanner->currentCommentLiteral())
+			create<ASTString>(m_scanner->currentCommentLiteral())
 		);
 	}
 	return nullptr;
@@ -198,7 +206,7 @@ ASTPointer<ImportDirective> Parser::parseImportDirective()
 	ASTNodeFactory nodeFactory(*this);
 	expectToken(Token::Import);
 	ASTPointer<ASTString> path;
-	ASTPointer<ASTString> unitAlias = make_shared<string>();
+	ASTPointer<ASTString> unitAlias = create<ASTString>();
 	ImportDirective::SymbolAliasList symbolAliases;
 
 	if (m_scanner->currentToken() == Token::StringLiteral)
@@ -569,7 +577,7 @@ ASTPointer<ASTNode> Parser::parseFunctionDefinition()
 				{Token::Fallback, "fallback function"},
 				{Token::Receive, "receive function"},
 			}.at(m_scanner->currentToken());
-			name = make_shared<ASTString>(TokenTraits::toString(m_scanner->currentToken()));
+			name = create<ASTString>(TokenTraits::toString(m_scanner->currentToken()));
 			string message{
 				"This function is named \"" + *name + "\" but is not the " + expected + " of the contract. "
 				"If you intend this to be a " + expected + ", use \"" + *name + "(...) { ... }\" without "
@@ -588,7 +596,7 @@ ASTPointer<ASTNode> Parser::parseFunctionDefinition()
 	{
 		solAssert(kind == Token::Constructor || kind == Token::Fallback || kind == Token::Receive, "");
 		m_scanner->next();
-		name = make_shared<ASTString>();
+		name = create<ASTString>();
 	}
 
 	FunctionHeaderParserResult header = parseFunctionHeader(false);
@@ -775,7 +783,7 @@ ASTPointer<VariableDeclaration> Parser::parseVariableDeclaration(
 
 	if (_options.allowEmptyName && m_scanner->currentToken() != Token::Identifier)
 	{
-		identifier = make_shared<ASTString>("");
+		identifier = create<ASTString>("");
 		solAssert(!_options.allowVar, ""); // allowEmptyName && allowVar makes no sense
 	}
 	else
@@ -1118,7 +1126,7 @@ ASTPointer<Statement> Parser::parseStatement()
 	try
 	{
 		if (m_scanner->currentCommentLiteral() != "")
-			docString = make_shared<ASTString>(m_scanner->currentCommentLiteral());
+			docString = create<ASTString>(m_scanner->currentCommentLiteral());
 		switch (m_scanner->currentToken())
 		{
 		case Token::If:
@@ -1217,7 +1225,7 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = block->location.end;
-	return make_shared<InlineAssembly>(nextID(), location, _docString, dialect, block);
+	return trackNode(create<InlineAssembly>(nextID(), location, _docString, dialect, block));
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
@@ -1262,7 +1270,7 @@ ASTPointer<TryStatement> Parser::parseTryStatement(ASTPointer<ASTString> const&
 	ASTPointer<Block> successBlock = parseBlock();
 	successClauseFactory.setEndPositionFromNode(successBlock);
 	clauses.emplace_back(successClauseFactory.createNode<TryCatchClause>(
-		make_shared<ASTString>(), returnsParameters, successBlock
+		create<ASTString>(), returnsParameters, successBlock
 	));
 
 	do
@@ -1281,7 +1289,7 @@ ASTPointer<TryCatchClause> Parser::parseCatchClause()
 	RecursionGuard recursionGuard(*this);
 	ASTNodeFactory nodeFactory(*this);
 	expectToken(Token::Catch);
-	ASTPointer<ASTString> errorName = make_shared<string>();
+	ASTPointer<ASTString> errorName = create<ASTString>();
 	ASTPointer<ParameterList> errorParameters;
 	if (m_scanner->currentToken() != Token::LBrace)
 	{
@@ -1744,7 +1752,7 @@ ASTPointer<Expression> Parser::parseLeftHandSideExpression(
 			nodeFactory.markEndPosition();
 			if (m_scanner->currentToken() == Token::Address)
 			{
-				expression = nodeFactory.createNode<MemberAccess>(expression, make_shared<ASTString>("address"));
+				expression = nodeFactory.createNode<MemberAccess>(expression, create<ASTString>("address"));
 				m_scanner->next();
 			}
 			else
@@ -1838,7 +1846,7 @@ ASTPointer<Expression> Parser::parsePrimaryExpression()
 		m_scanner->next();
 		if (m_scanner->currentToken() == Token::Illegal)
 			fatalParserError(to_string(m_scanner->currentError()));
-		expression = nodeFactory.createNode<Literal>(token, make_shared<ASTString>(literal));
+		expression = nodeFactory.createNode<Literal>(token, create<ASTString>(literal));
 		break;
 	}
 	case Token::Identifier:
@@ -1849,7 +1857,7 @@ ASTPointer<Expression> Parser::parsePrimaryExpression()
 		// Inside expressions "type" is the name of a special, globally-available function.
 		nodeFactory.markEndPosition();
 		m_scanner->next();
-		expression = nodeFactory.createNode<Identifier>(make_shared<ASTString>("type"));
+		expression = nodeFactory.createNode<Identifier>(create<ASTString>("type"));
 		break;
 	case Token::LParen:
 	case Token::LBrack:
@@ -2101,7 +2109,7 @@ ASTPointer<Expression> Parser::expressionFromIndexAccessStructure(
 		Identifier const& identifier = dynamic_cast<Identifier const&>(*_iap.path[i]);
 		expression = nodeFactory.createNode<MemberAccess>(
 			expression,
-			make_shared<ASTString>(identifier.name())
+			create<ASTString>(identifier.name())
 		);
 	}
 	for (auto const& index: _iap.indices)
@@ -2132,7 +2140,7 @@ ASTPointer<ASTString> Parser::expectIdentifierToken()
 
 ASTPointer<ASTString> Parser::getLiteralAndAdvance()
 {
-	ASTPointer<ASTString> identifier = make_shared<ASTString>(m_scanner->currentLiteral());
+	ASTPointer<ASTString> identifier = create<ASTString>(m_scanner->currentLiteral());
 	m_scanner->next();
 	return identifier;
 }
@@ -25,6 +25,7 @@
 #include <libsolidity/ast/AST.h>
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/EVMVersion.h>
+#include <libsolutil/Arena.h>
 
 namespace solidity::langutil
 {
@@ -48,6 +49,19 @@ public:
 
 	ASTPointer<SourceUnit> parse(std::shared_ptr<langutil::Scanner> const& _scanner);
 
+	/// @returns the ID of the last AST node created by this parser.
+	/// IDs are assigned consecutively, starting with one by default.
+	int64_t lastNodeID() const { return m_currentNodeID; }
+	/// Continues the IDs after @a _nodeID, so that they do not clash with the IDs of
+	/// nodes created by another parser.
+	void continueNodeIDsAfter(int64_t _nodeID) { m_currentNodeID = _nodeID; }
+
+	/// Keeps references to all AST nodes created from now on, including nodes
+	/// discarded during error recovery, so that they can be renumbered by shiftNodeIDs.
+	void enableNodeTracking() { m_trackNodes = true; }
+	/// Adds @a _offset to the IDs of all tracked nodes and stops referencing them.
+	void shiftNodeIDs(int64_t _offset);
+
 private:
 	class ASTNodeFactory;
 
@@ -177,6 +191,20 @@ private:
 
 	/// Returns the next AST node ID
 	int64_t nextID() { return ++m_currentNodeID; }
+	/// Creates an object in the arena of the source unit being parsed.
+	template <class T, typename... Args>
+	ASTPointer<T> create(Args&&... _args)
+	{
+		return std::allocate_shared<T>(util::ArenaAllocator<T>(m_arena), std::forward<Args>(_args)...);
+	}
+	/// Stores a reference to @a _node if node tracking is enabled and @returns the node.
+	template <class NodeType>
+	ASTPointer<NodeType> trackNode(ASTPointer<NodeType> _node)
+	{
+		if (m_trackNodes)
+			m_trackedNodes.push_back(_node);
+		return _node;
+	}
 
 	std::pair<LookAheadInfo, IndexAccessedPath> tryParseIndexAccessedPath();
 	/// Performs limited look-ahead to distinguish between variable declaration and expression statement.
@@ -205,6 +233,11 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	bool m_trackNodes = false;
+	std::vector<ASTPointer<ASTNode>> m_trackedNodes;
+	/// Backs the nodes of the source unit being parsed and their string objects, but not the
+	/// characters of the strings. Kept alive by the objects allocated in it.
+	std::shared_ptr<util::Arena> m_arena;
 };
 
 }
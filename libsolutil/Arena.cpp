@@ -0,0 +1,37 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Bump allocator for many small objects with a common lifetime.
+ */
+
+#include <libsolutil/Arena.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity::util;
+
+void* Arena::allocateInNewBlock(size_t _size, size_t _alignment)
+{
+	size_t blockSize = max(m_nextBlockSize, _size + _alignment);
+	m_nextBlockSize = min(m_nextBlockSize * 2, MaxBlockSize);
+	m_blocks.emplace_back(new char[blockSize]);
+	m_reservedBytes += blockSize;
+	m_current = m_blocks.back().get();
+	m_remaining = blockSize;
+	return allocate(_size, _alignment);
+}
@@ -0,0 +1,98 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Bump allocator for many small objects with a common lifetime.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Memory region that hands out memory by incrementing a pointer and releases all of it
+ * at once when it is destroyed. Individual allocations are never freed.
+ * Allocation is not thread-safe.
+ */
+class Arena
+{
+public:
+	Arena() = default;
+	Arena(Arena const&) = delete;
+	Arena& operator=(Arena const&) = delete;
+
+	void* allocate(std::size_t _size, std::size_t _alignment)
+	{
+		std::size_t padding = (_alignment - reinterpret_cast<std::uintptr_t>(m_current) % _alignment) % _alignment;
+		if (padding + _size > m_remaining)
+			return allocateInNewBlock(_size, _alignment);
+		void* result = m_current + padding;
+		m_current += padding + _size;
+		m_remaining -= padding + _size;
+		return result;
+	}
+
+	/// @returns the number of bytes reserved from the system.
+	std::size_t reservedBytes() const { return m_reservedBytes; }
+
+private:
+	void* allocateInNewBlock(std::size_t _size, std::size_t _alignment);
+
+	static std::size_t constexpr InitialBlockSize = 16 * 1024;
+	static std::size_t constexpr MaxBlockSize = 1024 * 1024;
+
+	std::vector<std::unique_ptr<char[]>> m_blocks;
+	char* m_current = nullptr;
+	std::size_t m_remaining = 0;
+	std::size_t m_nextBlockSize = InitialBlockSize;
+	std::size_t m_reservedBytes = 0;
+};
+
+/**
+ * Standard allocator that allocates from an Arena. It shares the ownership of the arena,
+ * so the arena lives as long as any object allocated via std::allocate_shared with it.
+ */
+template <class T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ArenaAllocator(std::shared_ptr<Arena> _arena): m_arena(std::move(_arena)) {}
+	template <class U>
+	ArenaAllocator(ArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(std::size_t _count) { return static_cast<T*>(m_arena->allocate(_count * sizeof(T), alignof(T))); }
+	void deallocate(T*, std::size_t) {}
+
+	std::shared_ptr<Arena> const& arena() const { return m_arena; }
+
+	template <class U>
+	bool operator==(ArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <class U>
+	bool operator!=(ArenaAllocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+private:
+	std::shared_ptr<Arena> m_arena;
+};
+
+}
@@ -18,10 +18,17 @@
 #pragma once
 
 #include <map>
+#include <optional>
 #include <set>
+#include <utility>
+#include <vector>
 
 /**
  * Data structure that keeps track of values and keys of a mapping.
+ *
+ * While a snapshot is active, every modification records the previous value of the
+ * modified key, so that the map can later be joined with the state at the time of the
+ * snapshot in time proportional to the number of changes instead of the size of the map.
  */
 template <class K, class V>
 struct InvertibleMap
@@ -33,7 +40,12 @@ struct InvertibleMap
 	void set(K _key, V _value)
 	{
 		if (values.count(_key))
+		{
+			record(_key, values[_key]);
 			references[values[_key]].erase(_key);
+		}
+		else
+			record(_key, std::nullopt);
 		values[_key] = _value;
 		references[_value].insert(_key);
 	}
@@ -41,7 +53,10 @@ struct InvertibleMap
 	void eraseKey(K _key)
 	{
 		if (values.count(_key))
+		{
+			record(_key, values[_key]);
 			references[values[_key]].erase(_key);
+		}
 		values.erase(_key);
 	}
 
@@ -49,17 +64,68 @@ struct InvertibleMap
 	{
 		if (references.count(_value))
 		{
-			for (V v: references[_value])
-				values.erase(v);
+			for (K const& k: references[_value])
+			{
+				record(k, _value);
+				values.erase(k);
+			}
 			references.erase(_value);
 		}
 	}
 
 	void clear()
 	{
+		for (auto const& item: values)
+			record(item.first, item.second);
 		values.clear();
 		references.clear();
 	}
+
+	/// Starts recording changes and returns a handle to the current state.
+	/// Every snapshot has to be released by joinWithSnapshot, in reverse order.
+	size_t snapshot()
+	{
+		++m_activeSnapshots;
+		return m_journal.size();
+	}
+
+	/// Releases the snapshot and removes all keys that did not exist at the time it was
+	/// taken or whose value has changed since then.
+	/// This is equivalent to joining with a copy taken at the time of the snapshot, since
+	/// that copy cannot contain keys that are not still known or were erased since.
+	void joinWithSnapshot(size_t _snapshot)
+	{
+		std::map<K, std::optional<V>> olderValues;
+		for (size_t i = _snapshot; i < m_journal.size(); ++i)
+			olderValues.emplace(m_journal[i]);
+
+		m_journal.resize(_snapshot);
+		--m_activeSnapshots;
+		// Only the oldest value of each key is relevant for the enclosing snapshots.
+		if (m_activeSnapshots > 0)
+			m_journal.insert(m_journal.end(), olderValues.begin(), olderValues.end());
+
+		for (auto const& [key, olderValue]: olderValues)
+		{
+			auto it = values.find(key);
+			if (it != values.end() && (!olderValue || *olderValue != it->second))
+			{
+				references[it->second].erase(key);
+				values.erase(it);
+			}
+		}
+	}
+
+private:
+	void record(K const& _key, std::optional<V> _previousValue)
+	{
+		if (m_activeSnapshots > 0)
+			m_journal.emplace_back(_key, std::move(_previousValue));
+	}
+
+	/// Keys modified since the oldest active snapshot together with their previous values.
+	std::vector<std::pair<K, std::optional<V>>> m_journal;
+	size_t m_activeSnapshots = 0;
 };
 
 template <class T>
@@ -0,0 +1,215 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Helper to distribute independent work items across worker threads.
+ */
+
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Profiler.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace solidity::util;
+
+namespace
+{
+
+/// Work items of one call of parallelFor. Threads of the pool help with it until
+/// it is closed by the calling thread, which then waits for them to finish.
+class Job
+{
+public:
+	Job(size_t _count, function<void(size_t)> const& _work):
+		m_work(_work),
+		m_count(_count),
+		m_exceptions(_count),
+		m_profiler(Profiler::current())
+	{}
+
+	/// Performs work items until there are none left or one of them failed.
+	void run()
+	{
+		Profiler::Scope profilerScope{m_profiler};
+		while (!m_failed)
+		{
+			size_t index = m_nextIndex++;
+			if (index >= m_count)
+				break;
+			try
+			{
+				m_work(index);
+			}
+			catch (...)
+			{
+				m_exceptions[index] = current_exception();
+				m_failed = true;
+			}
+		}
+	}
+
+	/// Runs the job in a thread of the pool unless it was already closed.
+	void help()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			if (m_closed)
+				return;
+			m_helpers++;
+		}
+		run();
+		lock_guard<mutex> lock(m_mutex);
+		if (--m_helpers == 0)
+			m_helpersDone.notify_all();
+	}
+
+	/// Prevents further threads from helping, waits for the current helpers and
+	/// rethrows the exception thrown for the smallest index, if any.
+	void finish()
+	{
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_closed = true;
+			m_helpersDone.wait(lock, [&] { return m_helpers == 0; });
+		}
+		for (exception_ptr const& exception: m_exceptions)
+			if (exception)
+				rethrow_exception(exception);
+	}
+
+private:
+	function<void(size_t)> const& m_work;
+	size_t const m_count;
+	vector<exception_ptr> m_exceptions;
+	Profiler* const m_profiler;
+	atomic<size_t> m_nextIndex{0};
+	atomic<bool> m_failed{false};
+
+	mutex m_mutex;
+	condition_variable m_helpersDone;
+	size_t m_helpers = 0;
+	bool m_closed = false;
+};
+
+/// Threads that are kept alive between calls of parallelFor, so that the threads are
+/// not created again for every call. The pool only grows when more threads are
+/// requested at the same time than are idle.
+class ThreadPool
+{
+public:
+	static ThreadPool& instance()
+	{
+		static ThreadPool pool;
+		return pool;
+	}
+
+	~ThreadPool()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stopped = true;
+		}
+		m_jobAvailable.notify_all();
+		for (thread& t: m_threads)
+			t.join();
+	}
+
+	/// Asks up to @a _helpers threads to help with @a _job.
+	void request(shared_ptr<Job> const& _job, size_t _helpers)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		for (size_t i = 0; i < _helpers; ++i)
+			m_requests.push_back(_job);
+		while (m_idleThreads < m_requests.size())
+			try
+			{
+				m_threads.emplace_back([this] { work(); });
+				m_idleThreads++;
+			}
+			catch (system_error const&)
+			{
+				// Threads are not available (or exhausted), continue with the ones we have.
+				break;
+			}
+		m_jobAvailable.notify_all();
+	}
+
+	/// Removes the requests for @a _job that were not taken up by a thread yet.
+	void withdraw(shared_ptr<Job> const& _job)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_requests.erase(remove(m_requests.begin(), m_requests.end(), _job), m_requests.end());
+	}
+
+private:
+	ThreadPool() = default;
+
+	void work()
+	{
+		unique_lock<mutex> lock(m_mutex);
+		while (true)
+		{
+			m_jobAvailable.wait(lock, [&] { return m_stopped || !m_requests.empty(); });
+			if (m_stopped)
+				return;
+			shared_ptr<Job> job = move(m_requests.front());
+			m_requests.pop_front();
+			m_idleThreads--;
+			lock.unlock();
+			job->help();
+			job.reset();
+			lock.lock();
+			m_idleThreads++;
+		}
+	}
+
+	mutex m_mutex;
+	condition_variable m_jobAvailable;
+	deque<shared_ptr<Job>> m_requests;
+	vector<thread> m_threads;
+	size_t m_idleThreads = 0;
+	bool m_stopped = false;
+};
+
+}
+
+void solidity::util::parallelFor(size_t _count, size_t _maxThreads, function<void(size_t)> const& _work)
+{
+	size_t const numThreads = min(_count, _maxThreads);
+	if (numThreads <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_work(i);
+		return;
+	}
+
+	auto job = make_shared<Job>(_count, _work);
+	ThreadPool& pool = ThreadPool::instance();
+	pool.request(job, numThreads - 1);
+	job->run();
+	pool.withdraw(job);
+	job->finish();
+}
@@ -0,0 +1,38 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Helper to distribute independent work items across worker threads.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace solidity::util
+{
+
+/// Calls @a _work for every index in [0, _count) using at most @a _maxThreads threads,
+/// one of which is the calling thread. Indices are handed out in increasing order, but
+/// the calls can run and complete in any order. If @a _maxThreads is at most one, all
+/// calls are performed sequentially in the calling thread. The other threads are taken
+/// from a pool that keeps them for later calls.
+/// If a call throws, no further indices are handed out and, once all threads are done,
+/// the exception thrown for the smallest index is rethrown in the calling thread.
+void parallelFor(size_t _count, size_t _maxThreads, std::function<void(size_t)> const& _work);
+
+}
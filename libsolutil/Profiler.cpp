@@ -0,0 +1,64 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Collection of wall-clock times and call counts of compiler phases.
+ */
+
+#include <libsolutil/Profiler.h>
+
+using namespace std;
+using namespace solidity::util;
+
+thread_local Profiler* Profiler::s_current = nullptr;
+
+Profiler::Timer::Timer(string_view _phase): m_profiler(s_current)
+{
+	if (m_profiler)
+	{
+		m_phase = _phase;
+		m_start = chrono::steady_clock::now();
+	}
+}
+
+Profiler::Timer::Timer(string_view _phase, string_view _subPhase): m_profiler(s_current)
+{
+	if (m_profiler)
+	{
+		m_phase = string(_phase) + "." + string(_subPhase);
+		m_start = chrono::steady_clock::now();
+	}
+}
+
+Profiler::Timer::~Timer()
+{
+	if (m_profiler)
+		m_profiler->record(m_phase, chrono::steady_clock::now() - m_start);
+}
+
+void Profiler::record(string const& _phase, chrono::nanoseconds _time)
+{
+	lock_guard<mutex> lock(m_mutex);
+	Entry& entry = m_entries[_phase];
+	entry.time += _time;
+	entry.calls++;
+}
+
+map<string, Profiler::Entry> Profiler::entries() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_entries;
+}
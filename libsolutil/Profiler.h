@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Collection of wall-clock times and call counts of compiler phases.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace solidity::util
+{
+
+/**
+ * Records the wall-clock time spent in and the number of calls of named compiler phases.
+ * Timers record into the profiler that is active in their thread. Without an active profiler,
+ * timers do nothing apart from a thread-local lookup. Recording is thread-safe, and
+ * parallelFor activates the profiler of the calling thread in its worker threads.
+ * Times of nested phases are also contained in the times of the enclosing phases.
+ */
+class Profiler
+{
+public:
+	struct Entry
+	{
+		std::chrono::nanoseconds time{0};
+		size_t calls = 0;
+	};
+
+	/// Activates a profiler for the current thread during its lifetime.
+	/// A null profiler disables recording.
+	class Scope
+	{
+	public:
+		explicit Scope(Profiler* _profiler): m_previous(s_current) { s_current = _profiler; }
+		~Scope() { s_current = m_previous; }
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+	private:
+		Profiler* m_previous = nullptr;
+	};
+
+	/// Measures the time from its construction to its destruction and records it
+	/// for the given phase in the profiler active at construction.
+	class Timer
+	{
+	public:
+		explicit Timer(std::string_view _phase);
+		/// Records for the phase "<_phase>.<_subPhase>", without composing the name if no
+		/// profiler is active.
+		Timer(std::string_view _phase, std::string_view _subPhase);
+		~Timer();
+		Timer(Timer const&) = delete;
+		Timer& operator=(Timer const&) = delete;
+	private:
+		Profiler* m_profiler = nullptr;
+		std::string m_phase;
+		std::chrono::steady_clock::time_point m_start;
+	};
+
+	/// @returns the profiler active in the current thread or nullptr.
+	static Profiler* current() { return s_current; }
+
+	void record(std::string const& _phase, std::chrono::nanoseconds _time);
+	std::map<std::string, Entry> entries() const;
+
+private:
+	static thread_local Profiler* s_current;
+
+	mutable std::mutex m_mutex;
+	std::map<std::string, Entry> m_entries;
+};
+
+}
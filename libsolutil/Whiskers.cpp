@@ -25,11 +25,47 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity::util;
 
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// @returns the end of the parameter name starting at @a _pos if it is followed by '>',
+/// and string::npos otherwise.
+size_t parameterNameEnd(string const& _template, size_t _pos, size_t _end)
+{
+	size_t pos = _pos;
+	while (pos < _end && isParameterCharacter(_template[pos]))
+		++pos;
+	if (pos == _pos || pos >= _end || _template[pos] != '>')
+		return string::npos;
+	return pos;
+}
+
+/// @returns the position of the first occurrence of @a _needle in @a _template
+/// in the range [_begin, _end) or string::npos.
+size_t findBefore(string const& _template, string const& _needle, size_t _begin, size_t _end)
+{
+	size_t pos = _template.find(_needle, _begin);
+	return (pos == string::npos || pos + _needle.size() > _end) ? string::npos : pos;
+}
+
+}
+
 Whiskers::Whiskers(string _template):
 	m_template(move(_template))
 {
@@ -67,14 +103,16 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	string output;
+	output.reserve(m_template.size() * 2);
+	render(*compile(m_template), m_parameters, nullptr, m_conditions, &m_listParameters, output);
+	return output;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -99,97 +137,167 @@ void Whiskers::checkParameterUnknown(string const& _parameter) const
 	);
 }
 
-namespace
-{
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
+shared_ptr<Whiskers::Sequence const> Whiskers::compile(string const& _template)
 {
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
+	// Most templates are string literals in the code generators, so the number of distinct
+	// templates is small. Templates assembled at runtime are bounded by clearing the cache.
+	static size_t constexpr maxCacheSize = 4096;
+	static shared_mutex cacheMutex;
+	static unordered_map<string, shared_ptr<Sequence const>> cache;
+
 	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
+		shared_lock<shared_mutex> lock(cacheMutex);
+		auto it = cache.find(_template);
+		if (it != cache.end())
+			return it->second;
 	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
+
+	shared_ptr<Sequence const> compiled = parse(_template, 0, _template.size());
+	unique_lock<shared_mutex> lock(cacheMutex);
+	if (cache.size() >= maxCacheSize)
+		cache.clear();
+	return cache.emplace(_template, move(compiled)).first->second;
 }
+
+shared_ptr<Whiskers::Sequence const> Whiskers::parse(string const& _template, size_t _begin, size_t _end)
+{
+	auto sequence = make_shared<Sequence>();
+	sequence->source = _template.substr(_begin, _end - _begin);
+	auto appendText = [&](size_t _from, size_t _to)
+	{
+		if (_from == _to)
+			return;
+		if (!sequence->segments.empty() && sequence->segments.back().kind == Segment::Kind::Text)
+			sequence->segments.back().content.append(_template, _from, _to - _from);
+		else
+			sequence->segments.push_back({Segment::Kind::Text, _template.substr(_from, _to - _from), nullptr, nullptr});
+	};
+
+	size_t textStart = _begin;
+	size_t pos = _begin;
+	while ((pos = _template.find('<', pos)) != string::npos && pos < _end)
+	{
+		char const marker = pos + 1 < _end ? _template[pos + 1] : '\0';
+		if (marker == '#' || marker == '?')
+		{
+			size_t nameEnd = parameterNameEnd(_template, pos + 2, _end);
+			if (nameEnd != string::npos)
+			{
+				string name = _template.substr(pos + 2, nameEnd - pos - 2);
+				size_t bodyBegin = nameEnd + 1;
+				string const closingTag = "</" + name + ">";
+				size_t closing = findBefore(_template, closingTag, bodyBegin, _end);
+				if (closing != string::npos)
+				{
+					Segment segment{
+						marker == '#' ? Segment::Kind::List : Segment::Kind::Condition,
+						move(name),
+						nullptr,
+						nullptr
+					};
+					size_t bodyEnd = closing;
+					if (marker == '?')
+					{
+						string const elseTag = "<!" + segment.content + ">";
+						size_t elsePos = findBefore(_template, elseTag, bodyBegin, closing);
+						if (elsePos != string::npos)
+						{
+							bodyEnd = elsePos;
+							segment.elseBody = parse(_template, elsePos + elseTag.size(), closing);
+						}
+					}
+					segment.body = parse(_template, bodyBegin, bodyEnd);
+					appendText(textStart, pos);
+					sequence->segments.push_back(move(segment));
+					pos = textStart = closing + closingTag.size();
+					continue;
+				}
+			}
+		}
+		else
+		{
+			size_t nameEnd = parameterNameEnd(_template, pos + 1, _end);
+			if (nameEnd != string::npos)
+			{
+				appendText(textStart, pos);
+				sequence->segments.push_back({Segment::Kind::Parameter, _template.substr(pos + 1, nameEnd - pos - 1), nullptr, nullptr});
+				pos = textStart = nameEnd + 1;
+				continue;
+			}
+		}
+		++pos;
+	}
+	appendText(textStart, _end);
+	return sequence;
 }
 
-string Whiskers::replace(
-	string const& _template,
+void Whiskers::render(
+	Sequence const& _sequence,
 	StringMap const& _parameters,
+	StringMap const* _listElement,
 	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
+	StringListMap const* _listParameters,
+	string& _output
 )
 {
-	static regex listOrTag("<(" + paramRegex() + ")>|<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|<\\?(" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>");
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
+	for (Segment const& segment: _sequence.segments)
+		switch (segment.kind)
+		{
+		case Segment::Kind::Text:
+			_output += segment.content;
+			break;
+		case Segment::Kind::Parameter:
 		{
+			if (_listElement)
+			{
+				auto it = _listElement->find(segment.content);
+				if (it != _listElement->end())
+				{
+					_output += it->second;
+					break;
+				}
+			}
+			auto it = _parameters.find(segment.content);
 			assertThrow(
-				_parameters.count(tagName),
+				it != _parameters.end(),
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + segment.content + " not provided.\n" +
 				"Template:\n" +
-				_template
+				_sequence.source
 			);
-			return _parameters.at(tagName);
+			_output += it->second;
+			break;
 		}
-		else if (!listName.empty())
+		case Segment::Kind::List:
 		{
-			string templ(_match[3]);
 			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
+				_listParameters && _listParameters->count(segment.content),
+				WhiskersError, "List parameter " + segment.content + " not set."
 			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			for (StringMap const& element: _listParameters->at(segment.content))
+			{
+				for (auto const& parameter: element)
+					assertThrow(
+						!_parameters.count(parameter.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				render(*segment.body, _parameters, &element, _conditions, nullptr, _output);
+			}
+			break;
 		}
-		else
+		case Segment::Kind::Condition:
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
+			auto it = _conditions.find(segment.content);
 			assertThrow(
-				_conditions.count(conditionName),
-				WhiskersError, "Condition parameter " + conditionName + " not set."
-			);
-			return replace(
-				_conditions.at(conditionName) ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
+				it != _conditions.end(),
+				WhiskersError, "Condition parameter " + segment.content + " not set."
 			);
+			if (it->second)
+				render(*segment.body, _parameters, _listElement, _conditions, _listParameters, _output);
+			else if (segment.elseBody)
+				render(*segment.elseBody, _parameters, _listElement, _conditions, _listParameters, _output);
+			break;
+		}
 		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
 }
-
@@ -25,8 +25,9 @@
 
 #include <libsolutil/Exceptions.h>
 
-#include <string>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace solidity::util
@@ -85,23 +86,47 @@ public:
 	std::string render() const;
 
 private:
+	struct Segment;
+	/// A template or the body of a list or condition, split into segments.
+	struct Sequence
+	{
+		/// The source text of the sequence, used in error messages.
+		std::string source;
+		std::vector<Segment> segments;
+	};
+	struct Segment
+	{
+		enum class Kind { Text, Parameter, List, Condition };
+		Kind kind;
+		/// The text for Text segments, the parameter name otherwise.
+		std::string content;
+		/// Body of a list or the branch taken for a true condition.
+		std::shared_ptr<Sequence const> body;
+		/// Branch taken for a false condition. Empty if there is no "<!name>".
+		std::shared_ptr<Sequence const> elseBody;
+	};
+
 	// Prevent implicit cast to bool
 	Whiskers& operator()(std::string _parameter, long long);
 	void checkParameterValid(std::string const& _parameter) const;
 	void checkParameterUnknown(std::string const& _parameter) const;
 
-	static std::string replace(
-		std::string const& _template,
+	/// @returns the compiled form of @a _template, which is cached across instances.
+	static std::shared_ptr<Sequence const> compile(std::string const& _template);
+	static std::shared_ptr<Sequence const> parse(std::string const& _template, size_t _begin, size_t _end);
+
+	/// Appends the expansion of @a _sequence to @a _output. Parameters are looked up
+	/// in @a _listElement first (if provided) and in @a _parameters otherwise.
+	/// Lists are only allowed if @a _listParameters is provided.
+	static void render(
+		Sequence const& _sequence,
 		StringMap const& _parameters,
+		StringMap const* _listElement,
 		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
+		StringListMap const* _listParameters,
+		std::string& _output
 	);
 
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
-
 	std::string m_template;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
@@ -30,6 +30,8 @@
 
 #include <liblangutil/ErrorReporter.h>
 
+#include <libsolutil/Profiler.h>
+
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/algorithm/string.hpp>
 
@@ -45,6 +47,7 @@ using namespace solidity::langutil;
 
 bool AsmAnalyzer::analyze(Block const& _block)
 {
+	util::Profiler::Timer timer{"yul.analysis"};
 	m_success = true;
 	try
 	{
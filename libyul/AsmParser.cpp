@@ -63,9 +63,10 @@ unique_ptr<Block> Parser::parse(std::shared_ptr<Scanner> const& _scanner, bool _
 std::map<string, evmasm::Instruction> const& Parser::instructions()
 {
 	// Allowed instructions, lowercase names.
-	static map<string, evmasm::Instruction> s_instructions;
-	if (s_instructions.empty())
+	// Initialized once in a thread-safe way, since sources can be parsed concurrently.
+	static map<string, evmasm::Instruction> const s_instructions = []()
 	{
+		map<string, evmasm::Instruction> allowedInstructions;
 		for (auto const& instruction: evmasm::c_instructions)
 		{
 			if (
@@ -75,9 +76,10 @@ std::map<string, evmasm::Instruction> const& Parser::instructions()
 				continue;
 			string name = instruction.first;
 			transform(name.begin(), name.end(), name.begin(), [](unsigned char _c) { return tolower(_c); });
-			s_instructions[name] = instruction.second;
+			allowedInstructions[name] = instruction.second;
 		}
-	}
+		return allowedInstructions;
+	}();
 	return s_instructions;
 }
 
@@ -301,15 +303,16 @@ Expression Parser::parseExpression()
 
 std::map<evmasm::Instruction, string> const& Parser::instructionNames()
 {
-	static map<evmasm::Instruction, string> s_instructionNames;
-	if (s_instructionNames.empty())
+	static map<evmasm::Instruction, string> const s_instructionNames = []()
 	{
+		map<evmasm::Instruction, string> instructionNames;
 		for (auto const& instr: instructions())
-			s_instructionNames[instr.second] = instr.first;
+			instructionNames[instr.second] = instr.first;
 		// set the ambiguous instructions to a clear default
-		s_instructionNames[evmasm::Instruction::SELFDESTRUCT] = "selfdestruct";
-		s_instructionNames[evmasm::Instruction::KECCAK256] = "keccak256";
-	}
+		instructionNames[evmasm::Instruction::SELFDESTRUCT] = "selfdestruct";
+		instructionNames[evmasm::Instruction::KECCAK256] = "keccak256";
+		return instructionNames;
+	}();
 	return s_instructionNames;
 }
 
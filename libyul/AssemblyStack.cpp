@@ -246,6 +246,25 @@ string AssemblyStack::print() const
 	return m_parserResult->toString(&languageToDialect(m_language, m_evmVersion)) + "\n";
 }
 
+void AssemblyStack::loadAnalyzed(shared_ptr<Object> _object)
+{
+	yulAssert(_object, "");
+	yulAssert(_object->code, "");
+	yulAssert(_object->analysisInfo, "");
+	m_parserResult = move(_object);
+	m_analysisSuccessful = true;
+}
+
+bool AssemblyStack::loadParsed(shared_ptr<Object> _object)
+{
+	yulAssert(_object, "");
+	yulAssert(_object->code, "");
+	m_errors.clear();
+	m_analysisSuccessful = false;
+	m_parserResult = move(_object);
+	return analyzeParsed();
+}
+
 shared_ptr<Object> AssemblyStack::parserResult() const
 {
 	yulAssert(m_analysisSuccessful, "Analysis was not successful.");
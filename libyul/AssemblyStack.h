@@ -97,6 +97,14 @@ public:
 	/// Return the parsed and analyzed object.
 	std::shared_ptr<Object> parserResult() const;
 
+	/// Uses @a _object, which has been parsed and analyzed for the language of this stack
+	/// already, instead of parsing source code. The object is modified by optimize() and translate().
+	void loadAnalyzed(std::shared_ptr<Object> _object);
+	/// Uses @a _object, which has been parsed for the language of this stack, instead of
+	/// parsing source code and analyzes it.
+	/// @returns false if there were errors.
+	bool loadParsed(std::shared_ptr<Object> _object);
+
 private:
 	bool analyzeParsed();
 	bool analyzeParsed(yul::Object& _object);
@@ -0,0 +1,173 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * String abstraction that avoids copies.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+struct ResetState
+{
+	mutex scopeMutex;
+	size_t activeScopes = 0;
+	bool resetPending = false;
+
+	mutex callbackMutex;
+	vector<function<void()>> callbacks;
+};
+
+ResetState& resetState()
+{
+	static ResetState state;
+	return state;
+}
+
+}
+
+YulStringRepository::Scope::Scope()
+{
+	lock_guard<mutex> lock(resetState().scopeMutex);
+	++resetState().activeScopes;
+}
+
+YulStringRepository::Scope::~Scope()
+{
+	ResetState& state = resetState();
+	lock_guard<mutex> lock(state.scopeMutex);
+	if (--state.activeScopes == 0 && state.resetPending)
+	{
+		state.resetPending = false;
+		performReset();
+	}
+}
+
+YulStringRepository::ResetCallback::ResetCallback(function<void()> _fun)
+{
+	lock_guard<mutex> lock(resetState().callbackMutex);
+	resetState().callbacks.emplace_back(move(_fun));
+}
+
+YulStringRepository::YulStringRepository()
+{
+	clear();
+}
+
+YulStringRepository::~YulStringRepository()
+{
+	for (auto& chunk: m_chunks)
+		delete[] chunk.load();
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string const& _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	uint64_t h = hash(_string);
+	Shard& shard = m_shards[h % ShardCount];
+	{
+		shared_lock<shared_mutex> lock(shard.mutex);
+		if (size_t const* id = find(shard, h, _string))
+			return Handle{*id, h};
+	}
+
+	unique_lock<shared_mutex> lock(shard.mutex);
+	// Another thread might have inserted the string in the meantime.
+	if (size_t const* id = find(shard, h, _string))
+		return Handle{*id, h};
+	shard.strings.emplace_back(make_unique<string>(_string));
+	size_t id = publish(shard.strings.back().get());
+	shard.hashToID.emplace(h, id);
+
+	return Handle{id, h};
+}
+
+void YulStringRepository::reset()
+{
+	ResetState& state = resetState();
+	lock_guard<mutex> lock(state.scopeMutex);
+	if (state.activeScopes > 0)
+		state.resetPending = true;
+	else
+		performReset();
+}
+
+void YulStringRepository::performReset()
+{
+	vector<function<void()>> callbacks;
+	{
+		lock_guard<mutex> lock(resetState().callbackMutex);
+		callbacks = resetState().callbacks;
+	}
+	for (auto const& cb: callbacks)
+		cb();
+	instance().clear();
+}
+
+size_t const* YulStringRepository::find(Shard const& _shard, uint64_t _hash, string const& _string) const
+{
+	auto range = _shard.hashToID.equal_range(_hash);
+	for (auto it = range.first; it != range.second; ++it)
+		if (idToString(it->second) == _string)
+			return &it->second;
+	return nullptr;
+}
+
+size_t YulStringRepository::publish(string const* _string)
+{
+	size_t id = m_nextID.fetch_add(1);
+	size_t chunkIndex = id / ChunkSize;
+	yulAssert(chunkIndex < MaxChunks, "Too many distinct YulStrings.");
+	string const** chunk = m_chunks[chunkIndex].load(memory_order_acquire);
+	if (!chunk)
+	{
+		lock_guard<mutex> lock(m_chunkMutex);
+		chunk = m_chunks[chunkIndex].load(memory_order_acquire);
+		if (!chunk)
+		{
+			chunk = new string const*[ChunkSize]();
+			m_chunks[chunkIndex].store(chunk, memory_order_release);
+		}
+	}
+	chunk[id % ChunkSize] = _string;
+	return id;
+}
+
+void YulStringRepository::clear()
+{
+	for (auto& chunk: m_chunks)
+		delete[] chunk.exchange(nullptr);
+	for (Shard& shard: m_shards)
+	{
+		shard.hashToID.clear();
+		shard.strings.clear();
+	}
+	m_nextID = 0;
+
+	// The empty string always has ID zero.
+	Shard& shard = m_shards[emptyHash() % ShardCount];
+	shard.strings.emplace_back(make_unique<string>());
+	shard.hashToID.emplace(emptyHash(), publish(shard.strings.back().get()));
+}
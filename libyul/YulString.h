@@ -22,8 +22,14 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
 #include <vector>
 #include <string>
 #include <functional>
@@ -35,6 +41,13 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// The repository can be used from multiple threads at the same time. Strings are
+/// distributed over shards by their hash, each guarded by its own lock, and looking
+/// up the string for an ID does not take any lock.
+/// Compilations that run concurrently with others should hold a Scope for their
+/// whole duration. A reset requested while a scope is active is deferred until the
+/// last scope has ended.
 class YulStringRepository
 {
 public:
@@ -44,28 +57,31 @@ public:
 		std::uint64_t hash;
 	};
 
+	/// RAII object that marks a region in which YulStrings are in use. Calls to
+	/// reset() are deferred until all scopes have been destroyed.
+	class Scope: boost::noncopyable
+	{
+	public:
+		Scope();
+		~Scope();
+	};
+
 	static YulStringRepository& instance()
 	{
 		static YulStringRepository inst;
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	Handle stringToHandle(std::string const& _string);
+	std::string const& idToString(size_t _id) const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		std::string const* const* chunk = m_chunks.at(_id / ChunkSize).load(std::memory_order_acquire);
+		if (!chunk || !chunk[_id % ChunkSize])
+			throw std::out_of_range("Invalid YulString ID.");
+		return *chunk[_id % ChunkSize];
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
+	/// @returns the number of strings in the repository, including the empty string.
+	size_t size() const { return m_nextID.load(); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -84,37 +100,47 @@ public:
 	/// Use with care - there cannot be any dangling YulString references.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
-	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
+	/// If a Scope is active, the reset is only performed once the last scope ends.
+	static void reset();
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
-		ResetCallback(std::function<void()> _fun)
-		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
-		}
+		ResetCallback(std::function<void()> _fun);
 	};
 
 private:
-	YulStringRepository() = default;
-	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
-	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
+	static constexpr size_t ShardCount = 16;
+	static constexpr size_t ChunkSize = 4096;
+	static constexpr size_t MaxChunks = 65536;
 
-	static std::vector<std::function<void()>>& resetCallbacks()
+	struct Shard
 	{
-		static std::vector<std::function<void()>> callbacks;
-		return callbacks;
-	}
+		mutable std::shared_mutex mutex;
+		std::unordered_multimap<std::uint64_t, size_t> hashToID;
+		std::vector<std::unique_ptr<std::string>> strings;
+	};
+
+	YulStringRepository();
+	~YulStringRepository();
+	YulStringRepository(YulStringRepository const&) = delete;
+	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	/// @returns the ID of @a _string in @a _shard or nullptr if it is not present.
+	/// Requires at least a shared lock on the shard.
+	size_t const* find(Shard const& _shard, std::uint64_t _hash, std::string const& _string) const;
+	/// Assigns the next free ID to @a _string, which is owned by a shard.
+	size_t publish(std::string const* _string);
+	/// Removes all strings except the empty string. Not thread-safe.
+	void clear();
+	/// Runs the reset callbacks and clears the repository.
+	static void performReset();
+
+	std::array<Shard, ShardCount> m_shards;
+	/// Maps IDs to strings. Chunks are allocated on demand and never move.
+	std::array<std::atomic<std::string const**>, MaxChunks> m_chunks{};
+	std::mutex m_chunkMutex;
+	std::atomic<size_t> m_nextID{0};
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -155,6 +181,8 @@ public:
 	}
 
 	uint64_t hash() const { return m_handle.hash; }
+	/// @returns the ID of the string, which is only stable until the repository is reset.
+	size_t id() const { return m_handle.id; }
 
 private:
 	/// Handle of the string. Assumes that the empty string has ID zero.
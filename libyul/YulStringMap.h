@@ -0,0 +1,267 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Hash map and set keyed by the ID of YulStrings.
+ */
+
+#pragma once
+
+#include <libyul/YulString.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Map from YulString to @a V stored in a single array, using open addressing
+ * with linear probing on the ID of the string. Lookups neither compare hashes
+ * nor strings, which makes it faster than std::map<YulString, V> for the
+ * lookup-heavy state of the optimiser.
+ *
+ * The iteration order depends on the IDs of the strings, which depend on the
+ * order of their creation. It must not influence the output of the compiler,
+ * so only iterate if the order does not matter.
+ * References to elements are invalidated by insertions and erasures.
+ */
+template <class V>
+class YulStringMap
+{
+	using Slot = std::pair<YulString, V>;
+
+	template <class SlotType>
+	class Iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Slot;
+		using difference_type = std::ptrdiff_t;
+		using pointer = SlotType*;
+		using reference = SlotType&;
+
+		Iterator(YulStringMap const& _map, size_t _index): m_map(&_map), m_index(_index) { skipEmpty(); }
+
+		reference operator*() const { return const_cast<reference>(m_map->m_slots[m_index]); }
+		pointer operator->() const { return &**this; }
+		Iterator& operator++() { ++m_index; skipEmpty(); return *this; }
+		bool operator==(Iterator const& _other) const { return m_index == _other.m_index; }
+		bool operator!=(Iterator const& _other) const { return m_index != _other.m_index; }
+
+	private:
+		void skipEmpty()
+		{
+			while (m_index < m_map->m_slots.size() && !m_map->m_used[m_index])
+				++m_index;
+		}
+
+		YulStringMap const* m_map;
+		size_t m_index;
+	};
+
+public:
+	using iterator = Iterator<Slot>;
+	using const_iterator = Iterator<Slot const>;
+
+	YulStringMap() = default;
+	/// Copies the elements of @a _map, which has to be a map with YulString keys.
+	template <class Map>
+	explicit YulStringMap(Map const& _map)
+	{
+		for (auto const& [key, value]: _map)
+			(*this)[key] = value;
+	}
+
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	void clear() { m_slots.clear(); m_used.clear(); m_size = 0; }
+
+	size_t count(YulString _key) const { return findIndex(_key) < m_slots.size() ? 1 : 0; }
+
+	iterator find(YulString _key) { return iterator(*this, findIndex(_key)); }
+	const_iterator find(YulString _key) const { return const_iterator(*this, findIndex(_key)); }
+
+	V& at(YulString _key) { return const_cast<V&>(std::as_const(*this).at(_key)); }
+	V const& at(YulString _key) const
+	{
+		size_t index = findIndex(_key);
+		if (index >= m_slots.size())
+			throw std::out_of_range("YulStringMap::at");
+		return m_slots[index].second;
+	}
+
+	/// @returns the value for @a _key, inserting a value-initialized one if there is none.
+	V& operator[](YulString _key) { return m_slots[insertIndex(_key)].second; }
+
+	/// Inserts the value for @a _key if there is none yet.
+	/// @returns an iterator to the element and whether it was inserted.
+	std::pair<iterator, bool> emplace(YulString _key, V _value)
+	{
+		size_t sizeBefore = m_size;
+		size_t index = insertIndex(_key);
+		bool inserted = m_size > sizeBefore;
+		if (inserted)
+			m_slots[index].second = std::move(_value);
+		return {iterator(*this, index), inserted};
+	}
+
+	size_t erase(YulString _key)
+	{
+		size_t index = findIndex(_key);
+		if (index >= m_slots.size())
+			return 0;
+		// Backward shift deletion: move following elements of the probe sequence into the gap.
+		size_t mask = m_slots.size() - 1;
+		size_t gap = index;
+		for (size_t next = (gap + 1) & mask; m_used[next]; next = (next + 1) & mask)
+		{
+			size_t ideal = bucket(m_slots[next].first);
+			// Move the element if its ideal bucket is not cyclically within (gap, next].
+			if (((next - ideal) & mask) >= ((next - gap) & mask))
+			{
+				m_slots[gap] = std::move(m_slots[next]);
+				gap = next;
+			}
+		}
+		m_slots[gap] = Slot{};
+		m_used[gap] = false;
+		--m_size;
+		return 1;
+	}
+
+	iterator begin() { return iterator(*this, 0); }
+	iterator end() { return iterator(*this, m_slots.size()); }
+	const_iterator begin() const { return const_iterator(*this, 0); }
+	const_iterator end() const { return const_iterator(*this, m_slots.size()); }
+
+private:
+	size_t bucket(YulString _key) const
+	{
+		// Fibonacci hashing spreads the consecutive IDs over the table.
+		return static_cast<size_t>((uint64_t(_key.id()) * 0x9E3779B97F4A7C15ULL) >> (64 - m_bits));
+	}
+
+	/// @returns the index of @a _key or the size of the table if it is not present.
+	size_t findIndex(YulString _key) const
+	{
+		if (m_slots.empty())
+			return 0;
+		size_t mask = m_slots.size() - 1;
+		for (size_t index = bucket(_key); m_used[index]; index = (index + 1) & mask)
+			if (m_slots[index].first == _key)
+				return index;
+		return m_slots.size();
+	}
+
+	/// @returns the index of @a _key, inserting a value-initialized element if it is not present.
+	size_t insertIndex(YulString _key)
+	{
+		if ((m_size + 1) * 4 > m_slots.size() * 3)
+			rehash(m_slots.empty() ? 16 : m_slots.size() * 2);
+		size_t mask = m_slots.size() - 1;
+		size_t index = bucket(_key);
+		for (; m_used[index]; index = (index + 1) & mask)
+			if (m_slots[index].first == _key)
+				return index;
+		m_slots[index] = Slot{_key, V{}};
+		m_used[index] = true;
+		++m_size;
+		return index;
+	}
+
+	void rehash(size_t _capacity)
+	{
+		std::vector<Slot> slots(_capacity);
+		std::vector<bool> used(_capacity, false);
+		std::swap(slots, m_slots);
+		std::swap(used, m_used);
+		m_bits = 0;
+		while ((size_t(1) << m_bits) < _capacity)
+			++m_bits;
+		m_size = 0;
+		for (size_t i = 0; i < slots.size(); ++i)
+			if (used[i])
+				m_slots[insertIndex(slots[i].first)].second = std::move(slots[i].second);
+	}
+
+	std::vector<Slot> m_slots;
+	std::vector<bool> m_used;
+	size_t m_size = 0;
+	unsigned m_bits = 0;
+};
+
+/**
+ * Set of YulStrings with the same properties as YulStringMap.
+ */
+class YulStringSet
+{
+	struct Empty {};
+	using Map = YulStringMap<Empty>;
+
+	class Iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = YulString;
+		using difference_type = std::ptrdiff_t;
+		using pointer = YulString const*;
+		using reference = YulString const&;
+
+		explicit Iterator(Map::const_iterator _it): m_it(_it) {}
+		reference operator*() const { return m_it->first; }
+		pointer operator->() const { return &m_it->first; }
+		Iterator& operator++() { ++m_it; return *this; }
+		bool operator==(Iterator const& _other) const { return m_it == _other.m_it; }
+		bool operator!=(Iterator const& _other) const { return m_it != _other.m_it; }
+
+	private:
+		Map::const_iterator m_it;
+	};
+
+public:
+	using iterator = Iterator;
+	using const_iterator = Iterator;
+
+	YulStringSet() = default;
+	/// Copies the elements of @a _set, which has to be a range of YulStrings.
+	template <class Set>
+	explicit YulStringSet(Set const& _set)
+	{
+		for (YulString element: _set)
+			insert(element);
+	}
+
+	size_t size() const { return m_map.size(); }
+	bool empty() const { return m_map.empty(); }
+	void clear() { m_map.clear(); }
+	size_t count(YulString _element) const { return m_map.count(_element); }
+	bool insert(YulString _element) { return m_map.emplace(_element, Empty{}).second; }
+	bool emplace(YulString _element) { return insert(_element); }
+	size_t erase(YulString _element) { return m_map.erase(_element); }
+
+	Iterator begin() const { return Iterator(m_map.begin()); }
+	Iterator end() const { return Iterator(m_map.end()); }
+
+private:
+	Map m_map;
+};
+
+}
@@ -25,8 +25,12 @@
 #include <libyul/AsmData.h>
 #include <libyul/Utilities.h>
 
+#include <libevmasm/ConstantOptimisationMemo.h>
+
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
 
+#include <tuple>
 #include <variant>
 
 using namespace std;
@@ -87,6 +91,51 @@ struct MiniEVMInterpreter
 
 	EVMDialect const& m_dialect;
 };
+
+/// Representation of a constant that does not refer to YulStrings, so that it stays valid
+/// when the YulString repository is reset: either a number literal or a call of the
+/// builtin function with the given name.
+struct MemoisedRepresentation
+{
+	u256 value;
+	string functionName;
+	vector<MemoisedRepresentation> arguments;
+};
+
+MemoisedRepresentation memoise(Expression const& _expression)
+{
+	if (FunctionCall const* funCall = get_if<FunctionCall>(&_expression))
+	{
+		MemoisedRepresentation repr{0, funCall->functionName.name.str(), {}};
+		for (Expression const& argument: funCall->arguments)
+			repr.arguments.emplace_back(memoise(argument));
+		return repr;
+	}
+	return MemoisedRepresentation{valueOfLiteral(std::get<Literal>(_expression)), {}, {}};
+}
+
+Expression expression(MemoisedRepresentation const& _repr, langutil::SourceLocation const& _location)
+{
+	if (_repr.functionName.empty())
+		return Literal{_location, LiteralKind::Number, YulString{formatNumber(_repr.value)}, {}};
+	FunctionCall funCall{_location, Identifier{_location, YulString{_repr.functionName}}, {}};
+	for (MemoisedRepresentation const& argument: _repr.arguments)
+		funCall.arguments.emplace_back(expression(argument, _location));
+	return funCall;
+}
+
+/// Memo of the representations of constants, keyed by the EVM version, creation mode, runs and
+/// the constant. Contains nullptr if the literal is the cheapest representation.
+using RepresentationMemo = evmasm::ConstantOptimisationMemo<
+	tuple<langutil::EVMVersion, bool, size_t, u256>,
+	shared_ptr<MemoisedRepresentation const>
+>;
+
+RepresentationMemo& representationMemo()
+{
+	static RepresentationMemo memo;
+	return memo;
+}
 }
 
 void ConstantOptimiser::visit(Expression& _e)
@@ -97,12 +146,23 @@ void ConstantOptimiser::visit(Expression& _e)
 		if (literal.kind != LiteralKind::Number)
 			return;
 
-		if (
-			Expression const* repr =
-				RepresentationFinder(m_dialect, m_meter, locationOf(_e), m_cache)
-				.tryFindRepresentation(valueOfLiteral(literal))
-		)
-			_e = ASTCopier{}.translate(*repr);
+		u256 value = valueOfLiteral(literal);
+		shared_ptr<MemoisedRepresentation const> repr = representationMemo().get(
+			{m_dialect.evmVersion(), m_meter.isCreation(), m_meter.runs(), value},
+			[&]() -> shared_ptr<MemoisedRepresentation const> {
+				util::Profiler::Timer timer{"yul.constantOptimiser"};
+				if (
+					Expression const* repr =
+						RepresentationFinder(m_dialect, m_meter, locationOf(_e), m_cache)
+						.tryFindRepresentation(value)
+				)
+					return make_shared<MemoisedRepresentation const>(memoise(*repr));
+				return nullptr;
+			}
+		);
+		if (repr)
+			// The memoised representation might stem from a different literal.
+			_e = expression(*repr, locationOf(_e));
 	}
 	else
 		ASTModifier::visit(_e);
@@ -22,6 +22,8 @@
 
 #include <libyul/Exceptions.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity::yul;
 
@@ -136,7 +138,9 @@ BuiltinFunction const* WasmDialect::equalityFunction(YulString _type) const
 WasmDialect const& WasmDialect::instance()
 {
 	static std::unique_ptr<WasmDialect> dialect;
-	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	static std::mutex dialectMutex;
+	static YulStringRepository::ResetCallback callback{[&] { std::lock_guard<std::mutex> lock(dialectMutex); dialect.reset(); }};
+	std::lock_guard<std::mutex> lock(dialectMutex);
 	if (!dialect)
 		dialect = make_unique<WasmDialect>();
 	return *dialect;
@@ -111,6 +111,7 @@ template <typename T>
 std::vector<T> ASTCopier::translateVector(std::vector<T> const& _values)
 {
 	std::vector<T> translated;
+	translated.reserve(_values.size());
 	for (auto const& v: _values)
 		translated.emplace_back(translate(v));
 	return translated;
@@ -15,7 +15,7 @@
 	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 */
 /**
- * Optimiser component that calculates hash values for block prefixes.
+ * Optimiser component that calculates hash values for blocks and expressions.
  */
 
 #include <libyul/optimiser/BlockHasher.h>
@@ -32,7 +32,7 @@ namespace
 {
 static constexpr uint64_t compileTimeLiteralHash(char const* _literal, size_t _n)
 {
-	return (_n == 0) ? BlockHasher::fnvEmptyHash : (static_cast<uint64_t>(_literal[0]) * BlockHasher::fnvPrime) ^ compileTimeLiteralHash(_literal + 1, _n - 1);
+	return (_n == 0) ? ASTHasherBase::fnvEmptyHash : (static_cast<uint64_t>(_literal[0]) * ASTHasherBase::fnvPrime) ^ compileTimeLiteralHash(_literal + 1, _n - 1);
 }
 
 template<size_t N>
@@ -191,3 +191,39 @@ void BlockHasher::operator()(Block const& _block)
 	for (auto& externalReference: subBlockHasher.m_externalReferences)
 		(*this)(Identifier{{}, externalReference});
 }
+
+uint64_t ExpressionHasher::run(Expression const& _expression)
+{
+	ExpressionHasher hasher;
+	hasher.visit(_expression);
+	return hasher.m_hash;
+}
+
+void ExpressionHasher::operator()(Literal const& _literal)
+{
+	hash64(compileTimeLiteralHash("Literal"));
+	if (_literal.kind == LiteralKind::Number)
+	{
+		u256 value = valueOfNumberLiteral(_literal);
+		for (size_t i = 0; i < 4; ++i)
+			hash64(static_cast<uint64_t>(value >> (64 * i)));
+	}
+	else
+		hash64(_literal.value.hash());
+	hash64(_literal.type.hash());
+	hash8(static_cast<uint8_t>(_literal.kind));
+}
+
+void ExpressionHasher::operator()(Identifier const& _identifier)
+{
+	hash64(compileTimeLiteralHash("Identifier"));
+	hash64(_identifier.name.hash());
+}
+
+void ExpressionHasher::operator()(FunctionCall const& _funCall)
+{
+	hash64(compileTimeLiteralHash("FunctionCall"));
+	hash64(_funCall.functionName.name.hash());
+	hash64(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
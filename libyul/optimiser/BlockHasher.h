@@ -15,7 +15,7 @@
 	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 */
 /**
- * Optimiser component that calculates hash values for blocks.
+ * Optimiser component that calculates hash values for blocks and expressions.
  */
 #pragma once
 
@@ -27,6 +27,40 @@
 namespace solidity::yul
 {
 
+/**
+ * Base class of AST walkers that compute FNV hashes.
+ */
+class ASTHasherBase: public ASTWalker
+{
+public:
+	static constexpr uint64_t fnvPrime = 1099511628211u;
+	static constexpr uint64_t fnvEmptyHash = 14695981039346656037u;
+
+protected:
+	void hash8(uint8_t _value)
+	{
+		m_hash *= fnvPrime;
+		m_hash ^= _value;
+	}
+	void hash16(uint16_t _value)
+	{
+		hash8(static_cast<uint8_t>(_value & 0xFF));
+		hash8(static_cast<uint8_t>(_value >> 8));
+	}
+	void hash32(uint32_t _value)
+	{
+		hash16(static_cast<uint16_t>(_value & 0xFFFF));
+		hash16(static_cast<uint16_t>(_value >> 16));
+	}
+	void hash64(uint64_t _value)
+	{
+		hash32(static_cast<uint32_t>(_value & 0xFFFFFFFF));
+		hash32(static_cast<uint32_t>(_value >> 32));
+	}
+
+	uint64_t m_hash = fnvEmptyHash;
+};
+
 /**
  * Optimiser component that calculates hash values for blocks.
  * Syntactically equal blocks will have identical hashes and
@@ -41,7 +75,7 @@ namespace solidity::yul
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter
  */
-class BlockHasher: public ASTWalker
+class BlockHasher: public ASTHasherBase
 {
 public:
 
@@ -64,36 +98,11 @@ public:
 
 	static std::map<Block const*, uint64_t> run(Block const& _block);
 
-	static constexpr uint64_t fnvPrime = 1099511628211u;
-	static constexpr uint64_t fnvEmptyHash = 14695981039346656037u;
-
 private:
 	BlockHasher(std::map<Block const*, uint64_t>& _blockHashes): m_blockHashes(_blockHashes) {}
 
-	void hash8(uint8_t _value)
-	{
-		m_hash *= fnvPrime;
-		m_hash ^= _value;
-	}
-	void hash16(uint16_t _value)
-	{
-		hash8(static_cast<uint8_t>(_value & 0xFF));
-		hash8(static_cast<uint8_t>(_value >> 8));
-	}
-	void hash32(uint32_t _value)
-	{
-		hash16(static_cast<uint16_t>(_value & 0xFFFF));
-		hash16(static_cast<uint16_t>(_value >> 16));
-	}
-	void hash64(uint64_t _value)
-	{
-		hash32(static_cast<uint32_t>(_value & 0xFFFFFFFF));
-		hash32(static_cast<uint32_t>(_value >> 32));
-	}
-
 	std::map<Block const*, uint64_t>& m_blockHashes;
 
-	uint64_t m_hash = fnvEmptyHash;
 	struct VariableReference
 	{
 		size_t id = 0;
@@ -105,5 +114,28 @@ private:
 	size_t m_internalIdentifierCount = 0;
 };
 
+/**
+ * Optimiser component that calculates hash values for expressions.
+ * Syntactically equal expressions (in the sense of SyntacticallyEqual without
+ * any renaming of variables) will have identical hashes.
+ *
+ * In contrast to BlockHasher, names of variables are taken into account
+ * and number literals are hashed by their value.
+ */
+class ExpressionHasher: public ASTHasherBase
+{
+public:
+	using ASTWalker::operator();
+
+	void operator()(Literal const&) override;
+	void operator()(Identifier const&) override;
+	void operator()(FunctionCall const& _funCall) override;
+
+	static uint64_t run(Expression const& _expression);
+
+private:
+	ExpressionHasher() = default;
+};
+
 
 }
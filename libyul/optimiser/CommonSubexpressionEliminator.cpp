@@ -21,6 +21,7 @@
 
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
@@ -99,12 +100,16 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 	}
 	else
 	{
-		// TODO this search is rather inefficient.
-		for (auto const& [variable, value]: m_value)
+		auto candidates = m_variablesByValueHash.find(ExpressionHasher::run(_e));
+		if (candidates == m_variablesByValueHash.end())
+			return;
+		for (auto const& [variable, value]: candidates->second)
 		{
-			assertThrow(value.value, OptimizerException, "");
+			auto it = m_value.find(variable);
+			if (it == m_value.end() || it->second.value != value)
+				continue;
 			assertThrow(inScope(variable), OptimizerException, "");
-			if (SyntacticallyEqual{}(_e, *value.value))
+			if (SyntacticallyEqual{}(_e, *value))
 			{
 				_e = Identifier{locationOf(_e), variable};
 				break;
@@ -112,3 +117,10 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 		}
 	}
 }
+
+void CommonSubexpressionEliminator::assignValue(YulString _variable, Expression const* _value)
+{
+	DataFlowAnalyzer::assignValue(_variable, _value);
+	assertThrow(_value, OptimizerException, "");
+	m_variablesByValueHash[ExpressionHasher::run(*_value)][_variable] = _value;
+}
@@ -24,6 +24,8 @@
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/OptimiserStep.h>
 
+#include <unordered_map>
+
 namespace solidity::yul
 {
 
@@ -51,6 +53,13 @@ private:
 protected:
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
+
+	void assignValue(YulString _variable, Expression const* _value) override;
+
+private:
+	/// Variables by the hash of the value assigned to them, in the same order as in m_value.
+	/// Entries are not removed when the value is cleared, so they have to be checked against m_value.
+	std::unordered_map<uint64_t, std::map<YulString, Expression const*>> m_variablesByValueHash;
 };
 
 }
@@ -104,12 +104,11 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 void DataFlowAnalyzer::operator()(If& _if)
 {
 	clearKnowledgeIfInvalidated(*_if.condition);
-	InvertibleMap<YulString, YulString> storage = m_storage;
-	InvertibleMap<YulString, YulString> memory = m_memory;
+	auto snapshot = snapshotKnowledge();
 
 	ASTModifier::operator()(_if);
 
-	joinKnowledge(storage, memory);
+	joinKnowledge(snapshot);
 
 	Assignments assignments;
 	assignments(_if.body);
@@ -123,10 +122,9 @@ void DataFlowAnalyzer::operator()(Switch& _switch)
 	set<YulString> assignedVariables;
 	for (auto& _case: _switch.cases)
 	{
-		InvertibleMap<YulString, YulString> storage = m_storage;
-		InvertibleMap<YulString, YulString> memory = m_memory;
+		auto snapshot = snapshotKnowledge();
 		(*this)(_case.body);
-		joinKnowledge(storage, memory);
+		joinKnowledge(snapshot);
 
 		Assignments assignments;
 		assignments(_case.body);
@@ -331,33 +329,19 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 		m_memory.clear();
 }
 
-void DataFlowAnalyzer::joinKnowledge(
-	InvertibleMap<YulString, YulString> const& _olderStorage,
-	InvertibleMap<YulString, YulString> const& _olderMemory
-)
+pair<size_t, size_t> DataFlowAnalyzer::snapshotKnowledge()
 {
-	joinKnowledgeHelper(m_storage, _olderStorage);
-	joinKnowledgeHelper(m_memory, _olderMemory);
+	return {m_storage.snapshot(), m_memory.snapshot()};
 }
 
-void DataFlowAnalyzer::joinKnowledgeHelper(
-	InvertibleMap<YulString, YulString>& _this,
-	InvertibleMap<YulString, YulString> const& _older
-)
+void DataFlowAnalyzer::joinKnowledge(pair<size_t, size_t> _snapshot)
 {
-	// We clear if the key does not exist in the older map or if the value is different.
-	// This also works for memory because _older is an "older version"
+	// We clear if the key did not exist at the time of the snapshot or if the value is different.
+	// This also works for memory because the snapshot is an "older version"
 	// of m_memory and thus any overlapping write would have cleared the keys
 	// that are not known to be different inside m_memory already.
-	set<YulString> keysToErase;
-	for (auto const& item: _this.values)
-	{
-		auto it = _older.values.find(item.first);
-		if (it == _older.values.end() || it->second != item.second)
-			keysToErase.insert(item.first);
-	}
-	for (auto const& key: keysToErase)
-		_this.eraseKey(key);
+	m_storage.joinWithSnapshot(_snapshot.first);
+	m_memory.joinWithSnapshot(_snapshot.second);
 }
 
 bool DataFlowAnalyzer::inScope(YulString _variableName) const
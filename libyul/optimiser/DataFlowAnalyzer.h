@@ -118,7 +118,9 @@ protected:
 	/// for example at points where control flow is merged.
 	void clearValues(std::set<YulString> _names);
 
-	void assignValue(YulString _variable, Expression const* _value);
+	/// Registers @a _value as the current value of @a _variable. Derived classes can override
+	/// this to maintain additional indices of m_value.
+	virtual void assignValue(YulString _variable, Expression const* _value);
 
 	/// Clears knowledge about storage or memory if they may be modified inside the block.
 	void clearKnowledgeIfInvalidated(Block const& _block);
@@ -126,18 +128,14 @@ protected:
 	/// Clears knowledge about storage or memory if they may be modified inside the expression.
 	void clearKnowledgeIfInvalidated(Expression const& _expression);
 
+	/// Marks the current knowledge about storage and memory as a point in the control-flow
+	/// to join with later.
+	std::pair<size_t, size_t> snapshotKnowledge();
+
 	/// Joins knowledge about storage and memory with an older point in the control-flow.
-	/// This only works if the current state is a direct successor of the older point,
-	/// i.e. `_otherStorage` and `_otherMemory` cannot have additional changes.
-	void joinKnowledge(
-		InvertibleMap<YulString, YulString> const& _olderStorage,
-		InvertibleMap<YulString, YulString> const& _olderMemory
-	);
-
-	static void joinKnowledgeHelper(
-		InvertibleMap<YulString, YulString>& _thisData,
-		InvertibleMap<YulString, YulString> const& _olderData
-	);
+	/// This only works if the current state is a direct successor of the older point.
+	/// Only the entries that changed since the snapshot are inspected.
+	void joinKnowledge(std::pair<size_t, size_t> _snapshot);
 
 	/// Returns true iff the variable is in scope.
 	bool inScope(YulString _variableName) const;
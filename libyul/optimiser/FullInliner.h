@@ -26,6 +26,7 @@
 #include <libyul/optimiser/NameDispenser.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/Exceptions.h>
+#include <libyul/YulStringMap.h>
 
 #include <liblangutil/SourceLocation.h>
 
@@ -102,12 +103,12 @@ private:
 	Block& m_ast;
 	std::map<YulString, FunctionDefinition*> m_functions;
 	/// Functions not to be inlined (because they contain the ``leave`` statement).
-	std::set<YulString> m_noInlineFunctions;
+	YulStringSet m_noInlineFunctions;
 	/// Names of functions to always inline.
-	std::set<YulString> m_singleUse;
+	YulStringSet m_singleUse;
 	/// Variables that are constants (used for inlining heuristic)
-	std::set<YulString> m_constants;
-	std::map<YulString, size_t> m_functionSizes;
+	YulStringSet m_constants;
+	YulStringMap<size_t> m_functionSizes;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
 };
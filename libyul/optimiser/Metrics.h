@@ -21,6 +21,7 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/YulStringMap.h>
 #include <liblangutil/EVMVersion.h>
 
 namespace solidity::yul
@@ -103,7 +104,7 @@ public:
 	void operator()(Assignment const& _assignment) override;
 	std::size_t assignmentCount(YulString _name) const;
 private:
-	std::map<YulString, size_t> m_assignmentCounters;
+	YulStringMap<size_t> m_assignmentCounters;
 };
 
 }
@@ -22,6 +22,7 @@
 
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/YulStringMap.h>
 
 namespace solidity::yul
 {
@@ -74,8 +75,8 @@ protected:
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
 
-	std::map<YulString, size_t> m_referenceCounts;
-	std::set<YulString> m_varsToAlwaysRematerialize;
+	YulStringMap<size_t> m_referenceCounts;
+	YulStringSet m_varsToAlwaysRematerialize;
 };
 
 /**
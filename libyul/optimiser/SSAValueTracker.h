@@ -23,6 +23,7 @@
 
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/AsmData.h>
+#include <libyul/YulStringMap.h>
 
 #include <map>
 #include <set>
@@ -46,7 +47,7 @@ public:
 	void operator()(VariableDeclaration const& _varDecl) override;
 	void operator()(Assignment const& _assignment) override;
 
-	std::map<YulString, Expression const*> const& values() const { return m_values; }
+	YulStringMap<Expression const*> const& values() const { return m_values; }
 	Expression const* value(YulString _name) const { return m_values.at(_name); }
 
 	static std::set<YulString> ssaVariables(Block const& _ast);
@@ -57,7 +58,7 @@ private:
 	/// Special expression whose address will be used in m_values.
 	/// YulString does not need to be reset because SSAValueTracker is short-lived.
 	Expression const m_zero{Literal{{}, LiteralKind::Number, YulString{"0"}, {}}};
-	std::map<YulString, Expression const*> m_values;
+	YulStringMap<Expression const*> m_values;
 };
 
 }
@@ -36,6 +36,35 @@ using namespace solidity::evmasm;
 using namespace solidity::langutil;
 using namespace solidity::yul;
 
+namespace
+{
+
+/// @returns the kind of @a _expr as seen by patterns that are not of kind "Any",
+/// i.e. after resolving variables with known values.
+SimplificationRuleIndex::ArgumentKind argumentKind(
+	Expression const& _expr,
+	Dialect const& _dialect,
+	map<YulString, AssignedValue> const& _ssaValues
+)
+{
+	Expression const* expr = &_expr;
+	if (holds_alternative<Identifier>(_expr))
+	{
+		auto it = _ssaValues.find(std::get<Identifier>(_expr).name);
+		if (it != _ssaValues.end() && it->second.value)
+			expr = it->second.value;
+	}
+
+	if (holds_alternative<Literal>(*expr) && std::get<Literal>(*expr).kind == LiteralKind::Number)
+		return SimplificationRuleIndex::Constant;
+	else if (auto instruction = SimplificationRules::instructionAndArguments(_dialect, *expr))
+		return SimplificationRuleIndex::operation(instruction->first);
+	else
+		return SimplificationRuleIndex::Other;
+}
+
+}
+
 SimplificationRule<yul::Pattern> const* SimplificationRules::findFirstMatch(
 	Expression const& _expr,
 	Dialect const& _dialect,
@@ -46,11 +75,17 @@ SimplificationRule<yul::Pattern> const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static SimplificationRules rules;
+	// The rules store the match groups of the last match, so every thread needs its own copy.
+	thread_local SimplificationRules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	SimplificationRuleIndex::Shape shape{};
+	for (size_t i = 0; i < min(shape.size(), instruction->second->size()); ++i)
+		shape[i] = argumentKind(instruction->second->at(i), _dialect, _ssaValues);
+
+	for (size_t index: rules.m_index.candidates(instruction->first, shape))
 	{
+		auto const& rule = rules.m_rules[uint8_t(instruction->first)][index];
 		rules.resetMatchGroups();
 		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
 			if (!rule.feasible || rule.feasible())
@@ -84,7 +119,16 @@ void SimplificationRules::addRules(vector<SimplificationRule<Pattern>> const& _r
 
 void SimplificationRules::addRule(SimplificationRule<Pattern> const& _rule)
 {
+	SimplificationRuleIndex::Shape shape{};
+	vector<Pattern> arguments = _rule.pattern.arguments();
+	for (size_t i = 0; i < min(shape.size(), arguments.size()); ++i)
+		if (arguments[i].kind() == PatternKind::Constant)
+			shape[i] = SimplificationRuleIndex::Constant;
+		else if (arguments[i].kind() == PatternKind::Operation)
+			shape[i] = SimplificationRuleIndex::operation(arguments[i].instruction());
+
 	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	m_index.addRule(_rule.pattern.instruction(), shape);
 }
 
 SimplificationRules::SimplificationRules()
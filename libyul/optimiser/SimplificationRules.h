@@ -21,6 +21,7 @@
 #pragma once
 
 #include <libevmasm/SimplificationRule.h>
+#include <libevmasm/SimplificationRuleIndex.h>
 
 #include <libyul/AsmDataForward.h>
 #include <libyul/AsmData.h>
@@ -71,6 +72,8 @@ private:
 
 	std::map<unsigned, Expression const*> m_matchGroups;
 	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
+	/// Rules in m_rules that can match expressions of a given shape.
+	evmasm::SimplificationRuleIndex m_index;
 };
 
 enum class PatternKind
@@ -107,6 +110,7 @@ public:
 	/// same expression equivalence class.
 	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
+	PatternKind kind() const { return m_kind; }
 	bool matches(
 		Expression const& _expr,
 		Dialect const& _dialect,
@@ -66,6 +66,7 @@
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
 
 #include <boost/range/algorithm_ext/erase.hpp>
 
@@ -299,16 +300,42 @@ void OptimiserSuite::runSequence(string const& _stepAbbreviations, Block& _ast)
 	}
 }
 
-void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
+bool OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 {
 	unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
 		copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+	// The ASTs are compared in printed form, which includes all names, types and literals.
+	// Only the printed form of the current AST is kept.
+	string code = AsmPrinter{}(_ast);
+	if (code != m_code)
+		++m_astVersion;
+	size_t const initialVersion = m_astVersion;
 	for (string const& step: _steps)
 	{
+		// Steps only depend on the AST, so a step that did not change the AST when it ran
+		// last will not change it now either if the AST has not changed in the meantime.
+		auto noOpVersion = m_noOpVersions.find(step);
+		if (noOpVersion != m_noOpVersions.end() && noOpVersion->second == m_astVersion)
+		{
+			if (m_debug == Debug::PrintStep)
+				cout << "Skipping " << step << endl;
+			continue;
+		}
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-		allSteps().at(step)->run(m_context, _ast);
+		{
+			util::Profiler::Timer timer{"yul.optimiser", step};
+			allSteps().at(step)->run(m_context, _ast);
+		}
+		string newCode = AsmPrinter{}(_ast);
+		if (newCode == code)
+			m_noOpVersions[step] = m_astVersion;
+		else
+		{
+			++m_astVersion;
+			code = move(newCode);
+		}
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -322,6 +349,8 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 			}
 		}
 	}
+	m_code = move(code);
+	return m_astVersion != initialVersion;
 }
 
 void OptimiserSuite::runSequenceUntilStable(
@@ -338,6 +367,7 @@ void OptimiserSuite::runSequenceUntilStable(
 			break;
 		codeSize = newSize;
 
-		runSequence(_steps, _ast);
+		if (!runSequence(_steps, _ast))
+			break;
 	}
 }
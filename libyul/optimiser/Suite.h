@@ -29,6 +29,7 @@
 #include <set>
 #include <string>
 #include <memory>
+#include <utility>
 
 namespace solidity::yul
 {
@@ -61,7 +62,9 @@ public:
 		std::set<YulString> const& _externallyUsedIdentifiers = {}
 	);
 
-	void runSequence(std::vector<std::string> const& _steps, Block& _ast);
+	/// Runs the given steps and @returns true if they changed the AST.
+	/// Steps are skipped if they did not change the AST and it did not change since.
+	bool runSequence(std::vector<std::string> const& _steps, Block& _ast);
 	void runSequence(std::string const& _stepAbbreviations, Block& _ast);
 	void runSequenceUntilStable(
 		std::vector<std::string> const& _steps,
@@ -88,6 +91,12 @@ private:
 	NameDispenser m_dispenser;
 	OptimiserStepContext m_context;
 	Debug m_debug;
+	/// Printed form of the AST after the last step run by runSequence.
+	std::string m_code;
+	/// Incremented whenever the printed form of the AST changes.
+	size_t m_astVersion = 0;
+	/// Version of the AST on which each step last ran without changing anything.
+	std::map<std::string, size_t> m_noOpVersions;
 };
 
 }
@@ -46,7 +46,7 @@ UnusedPruner::UnusedPruner(
 	m_allowMSizeOptimization(_allowMSizeOptimization),
 	m_functionSideEffects(_functionSideEffects)
 {
-	m_references = ReferencesCounter::countReferences(_ast);
+	m_references = YulStringMap<size_t>(ReferencesCounter::countReferences(_ast));
 	for (auto const& f: _externallyUsedFunctions)
 		++m_references[f];
 }
@@ -60,7 +60,7 @@ UnusedPruner::UnusedPruner(
 	m_dialect(_dialect),
 	m_allowMSizeOptimization(_allowMSizeOptimization)
 {
-	m_references = ReferencesCounter::countReferences(_function);
+	m_references = YulStringMap<size_t>(ReferencesCounter::countReferences(_function));
 	for (auto const& f: _externallyUsedFunctions)
 		++m_references[f];
 }
@@ -23,6 +23,7 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/YulString.h>
+#include <libyul/YulStringMap.h>
 
 #include <map>
 #include <set>
@@ -122,7 +123,7 @@ private:
 	bool m_allowMSizeOptimization = false;
 	std::map<YulString, SideEffects> const* m_functionSideEffects = nullptr;
 	bool m_shouldRunAgain = false;
-	std::map<YulString, size_t> m_references;
+	YulStringMap<size_t> m_references;
 };
 
 }
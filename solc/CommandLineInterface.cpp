@@ -50,6 +50,7 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
 
 #include <memory>
 
@@ -68,6 +69,8 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <iomanip>
+#include <chrono>
 
 #if !defined(STDERR_FILENO)
 	#define STDERR_FILENO 2
@@ -112,6 +115,7 @@ static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strCompactJSON = "compact-format";
 static string const g_strContracts = "contracts";
@@ -125,6 +129,7 @@ static string const g_strHelp = "help";
 static string const g_strImportAst = "import-ast";
 static string const g_strInputFile = "input-file";
 static string const g_strInterface = "interface";
+static string const g_strJobs = "jobs";
 static string const g_strYul = "yul";
 static string const g_strYulDialect = "yul-dialect";
 static string const g_strIR = "ir";
@@ -159,6 +164,7 @@ static set<string> const g_revertStringsArgs
 	revertStringsToString(RevertStrings::VerboseDebug)
 };
 
+static string const g_strServer = "server";
 static string const g_strSignatureHashes = "hashes";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
@@ -167,6 +173,7 @@ static string const g_strSrcMapRuntime = "srcmap-runtime";
 static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
 static string const g_strSwarm = "swarm";
+static string const g_strTimePasses = "time-passes";
 static string const g_strPrettyJson = "pretty-json";
 static string const g_strVersion = "version";
 static string const g_strIgnoreMissingFiles = "ignore-missing";
@@ -184,6 +191,7 @@ static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argAstJson = g_strAstJson;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
+static string const g_argCacheDir = g_strCacheDir;
 static string const g_argCombinedJson = g_strCombinedJson;
 static string const g_argCompactJSON = g_strCompactJSON;
 static string const g_argErrorRecovery = g_strErrorRecovery;
@@ -191,6 +199,7 @@ static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
 static string const g_argImportAst = g_strImportAst;
 static string const g_argInputFile = g_strInputFile;
+static string const g_argJobs = g_strJobs;
 static string const g_argYul = g_strYul;
 static string const g_argIR = g_strIR;
 static string const g_argIROptimized = g_strIROptimized;
@@ -207,10 +216,12 @@ static string const g_argOpcodes = g_strOpcodes;
 static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
 static string const g_argOutputDir = g_strOutputDir;
+static string const g_argServer = g_strServer;
 static string const g_argSignatureHashes = g_strSignatureHashes;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStorageLayout = g_strStorageLayout;
 static string const g_argStrictAssembly = g_strStrictAssembly;
+static string const g_argTimePasses = g_strTimePasses;
 static string const g_argVersion = g_strVersion;
 static string const g_stdinFileName = g_stdinFileNameStr;
 static string const g_argIgnoreMissingFiles = g_strIgnoreMissingFiles;
@@ -280,6 +291,17 @@ static void license()
 	exit(0);
 }
 
+static void printProfile(util::Profiler const& _profiler)
+{
+	serr() << left << setw(60) << "Phase" << right << setw(10) << "Calls" << setw(14) << "Time (ms)" << endl;
+	for (auto const& [phase, entry]: _profiler.entries())
+		serr() <<
+			left << setw(60) << phase <<
+			right << setw(10) << entry.calls <<
+			setw(14) << fixed << setprecision(3) << chrono::duration<double, milli>(entry.time).count() <<
+			endl;
+}
+
 static bool needsHumanTargetedStdout(po::variables_map const& _args)
 {
 	if (_args.count(g_argGas))
@@ -771,11 +793,35 @@ Allowed options)",
 			"Output a single json document containing the specified information."
 		)
 		(g_argGas.c_str(), "Print an estimate of the maximal gas usage for each function.")
+		(
+			g_argTimePasses.c_str(),
+			"Print the time spent in and the number of calls of each compilation phase and Yul optimiser step "
+			"to standard error. Times of nested phases are included in the times of the enclosing phases."
+		)
+		(
+			g_argJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Maximum number of threads used to parse the sources and to optimise and assemble the generated code "
+			"of the contracts. The code itself is still generated on a single thread. "
+			"The output does not depend on this setting."
+		)
 		(
 			g_argStandardJSON.c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_argServer.c_str(),
+			"Switch to Standard JSON server mode, ignoring all options except the allowed paths and the cache directory. "
+			"It reads one Standard JSON input per line from standard input and writes the output of each as a single line "
+			"to standard output, until the input is closed."
+		)
+		(
+			g_argCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Directory in which the results of Standard JSON compilations are cached. "
+			"Compilations with the same input, settings and compiler version are served from the cache."
+		)
 		(
 			g_argImportAst.c_str(),
 			"Import ASTs to be compiled, assumes input holds the AST in compact JSON format. "
@@ -1001,6 +1047,24 @@ bool CommandLineInterface::processInput()
 		}
 	}
 
+	if (m_args.count(g_argServer))
+	{
+		shared_ptr<ArtifactCache const> cache;
+		if (m_args.count(g_argCacheDir))
+			cache = make_shared<ArtifactCache>(m_args[g_argCacheDir].as<string>());
+		// A single compiler serves all requests, so that the process and its caches stay warm.
+		StandardCompiler compiler(fileReader, cache);
+		string input;
+		while (getline(cin, input))
+		{
+			if (boost::trim_copy(input).empty())
+				continue;
+			sout() << compiler.compile(input) << endl;
+			m_sourceCodes.clear();
+		}
+		return true;
+	}
+
 	if (m_args.count(g_argStandardJSON))
 	{
 		vector<string> inputFiles;
@@ -1019,11 +1083,20 @@ bool CommandLineInterface::processInput()
 			input = readStandardInput();
 		else
 			input = readFileAsString(jsonFile);
-		StandardCompiler compiler(fileReader);
+		shared_ptr<ArtifactCache const> cache;
+		if (m_args.count(g_argCacheDir))
+			cache = make_shared<ArtifactCache>(m_args[g_argCacheDir].as<string>());
+		StandardCompiler compiler(fileReader, cache);
 		sout() << compiler.compile(std::move(input)) << endl;
 		return true;
 	}
 
+	if (m_args.count(g_argCacheDir))
+	{
+		serr() << "Option --" << g_argCacheDir << " can only be used with --" << g_argStandardJSON << " or --" << g_argServer << "." << endl;
+		return false;
+	}
+
 	if (!readInputFilesAndConfigureRemappings())
 		return false;
 
@@ -1159,6 +1232,7 @@ bool CommandLineInterface::processInput()
 			m_compiler->setLibraries(m_libraries);
 		m_compiler->setEVMVersion(m_evmVersion);
 		m_compiler->setRevertStringBehaviour(m_revertStrings);
+		m_compiler->setParallelism(m_args[g_argJobs].as<unsigned>());
 		// TODO: Perhaps we should not compile unless requested
 
 		m_compiler->enableIRGeneration(m_args.count(g_argIR) || m_args.count(g_argIROptimized));
@@ -1197,7 +1271,14 @@ bool CommandLineInterface::processInput()
 				m_compiler->setParserErrorRecovery(true);
 		}
 
-		bool successful = m_compiler->compile();
+		util::Profiler profiler;
+		bool successful;
+		{
+			util::Profiler::Scope profilerScope{m_args.count(g_argTimePasses) ? &profiler : nullptr};
+			successful = m_compiler->compile();
+		}
+		if (m_args.count(g_argTimePasses))
+			printProfile(profiler);
 
 		for (auto const& error: m_compiler->errors())
 		{
@@ -1404,7 +1485,7 @@ void CommandLineInterface::handleAst(string const& _argStr)
 
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_argServer) || m_onlyAssemble)
 		// Already done in "processInput" phase.
 		return true;
 	else if (m_onlyLink)
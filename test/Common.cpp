@@ -95,6 +95,7 @@ CommonOptions::CommonOptions(std::string _caption):
 		("no-smt", po::bool_switch(&disableSMT), "disable SMT checker")
 		("optimize", po::bool_switch(&optimize), "enables optimization")
 		("optimize-yul", po::bool_switch(&optimizeYul), "enables Yul optimization")
+		("optimize-cse-across-blocks", po::bool_switch(&optimizeCSEAcrossBlocks), "enables common subexpression elimination across blocks, requires --optimize or --optimize-yul")
 		("abiencoderv2", po::bool_switch(&useABIEncoderV2), "enables abi encoder v2")
 		("show-messages", po::bool_switch(&showMessages), "enables message output")
 		("show-metadata", po::bool_switch(&showMetadata), "enables metadata output");
@@ -112,6 +113,11 @@ void CommonOptions::validate() const
 		ConfigException,
 		"Invalid test path specified."
 	);
+	assertThrow(
+		!optimizeCSEAcrossBlocks || optimize || optimizeYul,
+		ConfigException,
+		"--optimize-cse-across-blocks requires --optimize or --optimize-yul."
+	);
 
 }
 
@@ -53,6 +53,7 @@ ExecutionFramework::ExecutionFramework(langutil::EVMVersion _evmVersion):
 		m_optimiserSettings = solidity::frontend::OptimiserSettings::full();
 	else if (solidity::test::CommonOptions::get().optimize)
 		m_optimiserSettings = solidity::frontend::OptimiserSettings::standard();
+	m_optimiserSettings.runCSEAcrossBlocks = solidity::test::CommonOptions::get().optimizeCSEAcrossBlocks;
 
 	reset();
 }
@@ -410,6 +410,19 @@ SOLTMPDIR=$(mktemp -d)
     fi
 )
 
+printTask "Testing server mode..."
+(
+    request='{"language": "Solidity", "sources": {"a.sol": {"content": "contract C {}"}}, "settings": {"outputSelection": {"*": {"*": ["evm.bytecode.object"]}}}}'
+    output=$(printf '%s\n\n%s\n' "$request" "$request" | "$SOLC" --server)
+
+    # Every request is answered with a single line.
+    if [[ $(echo "$output" | wc -l) != 2 || $(echo "$output" | grep -c '"a.sol":{"C":{"evm":{"bytecode":{"object":"[0-9a-f]') != 2 ]]
+    then
+        printError "Incorrect output of server mode: $output"
+        exit 1
+    fi
+)
+
 printTask "Testing AST import..."
 SOLTMPDIR=$(mktemp -d)
 (
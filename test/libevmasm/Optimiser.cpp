@@ -28,6 +28,7 @@
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/Assembly.h>
+#include <libevmasm/ConstantOptimiser.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -807,6 +808,68 @@ BOOST_AUTO_TEST_CASE(control_flow_graph_do_not_remove_returned_to)
 	checkCFG(input, {u256(2)});
 }
 
+BOOST_AUTO_TEST_CASE(control_flow_graph_knowledge_at_block_starts)
+{
+	AssemblyItems input = addDummyLocations({
+		Instruction::CALLDATASIZE,
+		Instruction::DUP1,
+		u256(0),
+		Instruction::SSTORE,
+		u256(7),
+		u256(1),
+		Instruction::SSTORE,
+		u256(0),
+		Instruction::CALLDATALOAD,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		Instruction::STOP,
+		AssemblyItem(Tag, 1),
+		u256(7),
+		u256(1),
+		Instruction::SSTORE,
+		u256(0),
+		Instruction::SLOAD
+	});
+	map<size_t, KnownStatePointer> states = ControlFlowGraph{input}.knowledgeAtBlockStarts();
+	BOOST_REQUIRE(states.count(0));
+	BOOST_REQUIRE(states.count(11));
+	BOOST_REQUIRE(states.count(13));
+	// The store of a known value is removed and the value of slot zero is still on the stack.
+	checkCSE(
+		AssemblyItems(input.begin() + 13, input.end()),
+		AssemblyItems{Instruction::DUP1},
+		states.at(13)->relativeToStack()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(control_flow_graph_knowledge_after_assign_immutable)
+{
+	AssemblyItems input = addDummyLocations({
+		Instruction::CALLDATASIZE,
+		Instruction::DUP1,
+		u256(0),
+		Instruction::MSTORE,
+		u256(1),
+		AssemblyItem(AssignImmutable, 0x1234),
+		u256(0),
+		Instruction::CALLDATALOAD,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		Instruction::STOP,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::MLOAD
+	});
+	map<size_t, KnownStatePointer> states = ControlFlowGraph{input}.knowledgeAtBlockStarts();
+	BOOST_REQUIRE(states.count(12));
+	// AssignImmutable writes to memory, so the load is kept.
+	checkCSE(
+		AssemblyItems(input.begin() + 12, input.end()),
+		AssemblyItems{u256(0), Instruction::MLOAD},
+		states.at(12)->relativeToStack()
+	);
+}
+
 BOOST_AUTO_TEST_CASE(block_deduplicator)
 {
 	AssemblyItems input{
@@ -998,10 +1061,139 @@ BOOST_AUTO_TEST_CASE(peephole_pop_calldatasize)
 		Instruction::LT,
 		Instruction::POP
 	};
+	AssemblyItems extendedItems = items;
 	PeepholeOptimiser peepOpt(items);
 	for (size_t i = 0; i < 3; i++)
 		BOOST_CHECK(peepOpt.optimise());
 	BOOST_CHECK(items.empty());
+	// With the extended rules, the fixpoint is reached in a single run.
+	PeepholeOptimiser extendedPeepOpt(extendedItems, true);
+	BOOST_CHECK(extendedPeepOpt.optimise());
+	BOOST_CHECK(extendedItems.empty());
+	BOOST_CHECK(!extendedPeepOpt.optimise());
+}
+
+BOOST_AUTO_TEST_CASE(peephole_without_extended_rules)
+{
+	// Without the extended rules, the rules are applied from left to right and the result of a run
+	// is only used if the code gets smaller as a whole.
+	vector<pair<AssemblyItems, AssemblyItems>> const cases{
+		{
+			{Instruction::ADDMOD, Instruction::SUB, Instruction::POP},
+			{Instruction::ADDMOD, Instruction::POP, Instruction::POP}
+		},
+		{
+			{AssemblyItem(PushTag, 1), Instruction::MULMOD, Instruction::POP},
+			{AssemblyItem(PushTag, 1), Instruction::MULMOD, Instruction::POP}
+		},
+		{
+			{u256(1), u256(2), Instruction::ADDMOD, Instruction::POP},
+			{u256(1), u256(2), Instruction::ADDMOD, Instruction::POP}
+		},
+		{
+			{AssemblyItem(PushTag, 1), AssemblyItem(PushTag, 1), Instruction::JUMP, AssemblyItem(Tag, 1), Instruction::SUB},
+			{AssemblyItem(PushTag, 1), AssemblyItem(Tag, 1), Instruction::SUB}
+		},
+		{
+			{Instruction::DUP2, Instruction::SWAP2, u256(0), Instruction::SSTORE, Instruction::CALLVALUE, Instruction::DUP1, Instruction::ADD, Instruction::STOP},
+			{Instruction::DUP2, Instruction::SWAP2, u256(0), Instruction::SSTORE, Instruction::CALLVALUE, Instruction::DUP1, Instruction::ADD, Instruction::STOP}
+		}
+	};
+	for (auto const& [input, expectation]: cases)
+	{
+		AssemblyItems items = input;
+		PeepholeOptimiser peepOpt(items);
+		while (peepOpt.optimise())
+		{}
+		BOOST_CHECK_EQUAL_COLLECTIONS(
+			items.begin(), items.end(),
+			expectation.begin(), expectation.end()
+		);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(peephole_extended_rules_growing_replacement)
+{
+	// OpPop turns ADDMOD POP into three POPs, which is only kept if the POPs are removed afterwards.
+	vector<pair<AssemblyItems, AssemblyItems>> const cases{
+		{
+			{Instruction::ADDMOD, Instruction::SUB, Instruction::POP},
+			{Instruction::ADDMOD, Instruction::POP, Instruction::POP}
+		},
+		{
+			{AssemblyItem(PushTag, 1), Instruction::MULMOD, Instruction::POP},
+			{Instruction::POP, Instruction::POP}
+		},
+		{
+			{u256(1), u256(2), Instruction::ADDMOD, Instruction::POP},
+			{Instruction::POP}
+		},
+		{
+			{Instruction::ADDMOD, Instruction::SWAP1, Instruction::SWAP1, Instruction::DUP2, Instruction::MULMOD, Instruction::POP},
+			{Instruction::ADDMOD, Instruction::POP, Instruction::POP}
+		}
+	};
+	for (auto const& [input, expectation]: cases)
+	{
+		AssemblyItems items = input;
+		PeepholeOptimiser peepOpt(items, true);
+		peepOpt.optimise();
+		BOOST_CHECK(!peepOpt.optimise());
+		BOOST_CHECK_EQUAL_COLLECTIONS(
+			items.begin(), items.end(),
+			expectation.begin(), expectation.end()
+		);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(peephole_push_swap_pop)
+{
+	AssemblyItems items{
+		u256(1),
+		u256(2),
+		Instruction::SWAP1,
+		Instruction::POP,
+		Instruction::DUP2,
+		Instruction::SWAP1,
+		Instruction::POP
+	};
+	AssemblyItems expectation{
+		Instruction::DUP1
+	};
+	// The rule is only applied if the optimiser is enabled.
+	BOOST_CHECK(!PeepholeOptimiser(items).optimise());
+	PeepholeOptimiser peepOpt(items, true);
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(peephole_dup_swap_op_stop)
+{
+	AssemblyItems items{
+		Instruction::DUP2,
+		Instruction::SWAP2,
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::CALLVALUE,
+		Instruction::DUP1,
+		Instruction::ADD,
+		Instruction::STOP
+	};
+	AssemblyItems expectation{
+		Instruction::DUP2,
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	PeepholeOptimiser peepOpt(items, true);
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
 }
 
 BOOST_AUTO_TEST_CASE(peephole_commutative_swap1)
@@ -1254,6 +1446,41 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(constant_optimisation_memoised)
+{
+	// The second assembly reuses the memoised choice, but still gets its own data for code copies.
+	u256 const copied("0x8d2ab8f3a0e1d7c6b5a4938271605f4e3d2c1b0a99887766554433221100ffee");
+	u256 const computed = (u256(1) << 160) - 1;
+	vector<Assembly> assemblies(2);
+	for (Assembly& assembly: assemblies)
+	{
+		for (size_t i = 0; i < 3; ++i)
+		{
+			assembly.append(copied);
+			assembly.append(computed);
+		}
+		ConstantOptimisationMethod::optimiseConstants(
+			true,
+			1,
+			solidity::test::CommonOptions::get().evmVersion(),
+			assembly
+		);
+	}
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		assemblies[0].items().begin(), assemblies[0].items().end(),
+		assemblies[1].items().begin(), assemblies[1].items().end()
+	);
+	for (Assembly const& assembly: assemblies)
+	{
+		AssemblyItems const& items = assembly.items();
+		BOOST_CHECK(find(items.begin(), items.end(), AssemblyItem(copied)) == items.end());
+		BOOST_CHECK(find(items.begin(), items.end(), AssemblyItem(computed)) == items.end());
+		auto pushData = find_if(items.begin(), items.end(), [](AssemblyItem const& _item) { return _item.type() == PushData; });
+		BOOST_REQUIRE(pushData != items.end());
+		BOOST_CHECK(assembly.data(util::h256(pushData->data())) == util::toBigEndian(copied));
+	}
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
@@ -0,0 +1,196 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Tests for the incremental compilation mode of the compiler stack.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+map<string, string> const baseSources{
+	{"a.sol", "pragma solidity >=0.0; contract A { function f() public pure returns (uint) { uint unused; return 1; } }"},
+	{"b.sol", "pragma solidity >=0.0; import \"a.sol\"; contract B is A { function g() public returns (A) { return new A(); } }"},
+	{"c.sol", "pragma solidity >=0.0; contract C { function h() public pure returns (uint) { return 3; } }"}
+};
+
+void setup(CompilerStack& _compiler, map<string, string> const& _sources)
+{
+	_compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	_compiler.setOptimiserSettings(true);
+	_compiler.setSources(_sources);
+}
+
+size_t countWarnings(CompilerStack const& _compiler)
+{
+	size_t warnings = 0;
+	for (auto const& error: _compiler.errors())
+		if (error->type() == langutil::Error::Type::Warning)
+			warnings++;
+	return warnings;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(IncrementalCompilation)
+
+BOOST_AUTO_TEST_CASE(unchanged_sources_are_reused)
+{
+	CompilerStack compiler;
+	compiler.enableIncrementalCompilation();
+	setup(compiler, baseSources);
+	BOOST_REQUIRE(compiler.compile());
+	int64_t aID = compiler.ast("a.sol").id();
+	int64_t bID = compiler.ast("b.sol").id();
+	int64_t cID = compiler.ast("c.sol").id();
+	size_t warnings = countWarnings(compiler);
+	BOOST_CHECK(warnings > 0);
+
+	map<string, string> sources = baseSources;
+	sources["c.sol"] = "pragma solidity >=0.0; contract C { function h() public pure returns (uint) { return 4; } }";
+	compiler.reset(true);
+	compiler.setSources(sources);
+	BOOST_REQUIRE(compiler.compile());
+	BOOST_CHECK_EQUAL(compiler.ast("a.sol").id(), aID);
+	BOOST_CHECK_EQUAL(compiler.ast("b.sol").id(), bID);
+	BOOST_CHECK(compiler.ast("c.sol").id() != cID);
+	BOOST_CHECK_EQUAL(countWarnings(compiler), warnings);
+
+	// A change to a.sol also invalidates b.sol, which imports it.
+	sources["a.sol"] = "pragma solidity >=0.0; contract A { function f() public pure returns (uint) { uint unused; return 2; } }";
+	cID = compiler.ast("c.sol").id();
+	compiler.reset(true);
+	compiler.setSources(sources);
+	BOOST_REQUIRE(compiler.compile());
+	BOOST_CHECK(compiler.ast("a.sol").id() != aID);
+	BOOST_CHECK(compiler.ast("b.sol").id() != bID);
+	BOOST_CHECK_EQUAL(compiler.ast("c.sol").id(), cID);
+	BOOST_CHECK_EQUAL(countWarnings(compiler), warnings);
+}
+
+BOOST_AUTO_TEST_CASE(same_output_as_full_compilation)
+{
+	map<string, string> sources = baseSources;
+	sources["b.sol"] = "pragma solidity >=0.0; import \"a.sol\"; contract B is A { function g() public returns (A) { return new A(); } uint x; }";
+
+	CompilerStack incremental;
+	incremental.enableIncrementalCompilation();
+	setup(incremental, baseSources);
+	BOOST_REQUIRE(incremental.compile());
+	incremental.reset(true);
+	incremental.setSources(sources);
+	BOOST_REQUIRE(incremental.compile());
+
+	CompilerStack full;
+	setup(full, sources);
+	BOOST_REQUIRE(full.compile());
+
+	BOOST_CHECK_EQUAL(incremental.errors().size(), full.errors().size());
+	for (char const* contract: {"a.sol:A", "b.sol:B", "c.sol:C"})
+	{
+		BOOST_CHECK(incremental.object(contract).bytecode == full.object(contract).bytecode);
+		BOOST_CHECK_EQUAL(incremental.metadata(contract), full.metadata(contract));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(changed_members_across_cycles)
+{
+	map<string, string> sources{
+		{"a.sol", "pragma solidity >=0.0; library L { function twice(uint x) internal pure returns (uint) { return 2 * x; } }"},
+		{"b.sol", "pragma solidity >=0.0; import \"a.sol\"; contract B { using L for uint; struct S { uint v; } function b(uint x) public pure returns (uint) { return x.twice(); } }"}
+	};
+	CompilerStack incremental;
+	incremental.enableIncrementalCompilation();
+	int64_t bID = 0;
+	for (size_t cycle = 0; cycle < 6; ++cycle)
+	{
+		// The members of C, the types it uses and the functions bound to them change in every cycle,
+		// while a.sol and b.sol are reused.
+		string const n = to_string(cycle);
+		sources["c.sol"] =
+			"pragma solidity >=0.0; import \"b.sol\"; "
+			"library M" + n + " { function add" + n + "(uint x) internal pure returns (uint) { return x + " + n + "; } } "
+			"contract C is B { using L for uint; using M" + n + " for uint; "
+			"struct T" + n + " { uint v; B.S s; } T" + n + " t; "
+			"function f" + n + "(uint x) public returns (uint) { t.s.v = x.twice().add" + n + "(); return this.b(t.s.v) + t.v; } }";
+
+		incremental.reset(true);
+		setup(incremental, sources);
+		BOOST_REQUIRE(incremental.compile());
+		if (cycle == 0)
+			bID = incremental.ast("b.sol").id();
+		else
+			BOOST_CHECK_EQUAL(incremental.ast("b.sol").id(), bID);
+
+		CompilerStack full;
+		setup(full, sources);
+		BOOST_REQUIRE(full.compile());
+		for (char const* contract: {"b.sol:B", "c.sol:C"})
+			BOOST_CHECK(incremental.object(contract).bytecode == full.object(contract).bytecode);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(changed_settings_prevent_reuse)
+{
+	CompilerStack compiler;
+	compiler.enableIncrementalCompilation();
+	setup(compiler, baseSources);
+	BOOST_REQUIRE(compiler.compile());
+	int64_t cID = compiler.ast("c.sol").id();
+
+	// Without reuse, the node IDs are assigned from the start again.
+	map<string, string> sources = baseSources;
+	sources["c.sol"] = "pragma solidity >=0.0; contract C { function h() public pure returns (uint) { return 4; } }";
+	compiler.reset(true);
+	compiler.setOptimiserSettings(false);
+	compiler.setSources(sources);
+	BOOST_REQUIRE(compiler.compile());
+	BOOST_CHECK_EQUAL(compiler.ast("c.sol").id(), cID);
+}
+
+BOOST_AUTO_TEST_CASE(errors_prevent_reuse)
+{
+	CompilerStack compiler;
+	compiler.enableIncrementalCompilation();
+	map<string, string> sources = baseSources;
+	sources["c.sol"] = "pragma solidity >=0.0; contract C { function h() public pure returns (uint) { return x; } }";
+	setup(compiler, sources);
+	BOOST_CHECK(!compiler.compile());
+	int64_t cID = compiler.ast("c.sol").id();
+
+	compiler.reset(true);
+	compiler.setSources(baseSources);
+	BOOST_REQUIRE(compiler.compile());
+	BOOST_CHECK_EQUAL(compiler.ast("c.sol").id(), cID);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
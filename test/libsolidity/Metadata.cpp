@@ -302,6 +302,34 @@ BOOST_AUTO_TEST_CASE(metadata_revert_strings)
 	BOOST_CHECK_EQUAL(metadata["settings"]["debug"]["revertStrings"], "strip");
 }
 
+BOOST_AUTO_TEST_CASE(metadata_cse_across_blocks)
+{
+	char const* sourceCode = R"(
+		pragma solidity >=0.0;
+		contract A {
+		}
+	)";
+
+	auto check = [&](bool _runCSE)
+	{
+		CompilerStack compilerStack;
+		compilerStack.setSources({{"A", std::string(sourceCode)}});
+		OptimiserSettings settings = OptimiserSettings::standard();
+		settings.runCSE = _runCSE;
+		settings.runCSEAcrossBlocks = true;
+		compilerStack.setOptimiserSettings(settings);
+		BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contract failed");
+
+		Json::Value metadata;
+		BOOST_REQUIRE(util::jsonParseStrict(compilerStack.metadata("A"), metadata));
+		// The setting has no effect without the common subexpression eliminator.
+		BOOST_CHECK_EQUAL(metadata["settings"]["optimizer"]["details"].isMember("cseAcrossBlocks"), _runCSE);
+	};
+
+	check(true);
+	check(false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -22,9 +22,16 @@
 #include <test/Metadata.h>
 #include <test/Common.h>
 
+#include <libsolidity/codegen/CompilerContext.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libyul/YulString.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
+
 #include <boost/test/unit_test.hpp>
 
 using namespace std;
+using namespace solidity::util;
 
 namespace solidity::frontend::test
 {
@@ -51,6 +58,152 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(yul_function_sharing_does_not_change_output)
+{
+	map<string, string> sources{
+		{"a.sol", R"(
+			pragma experimental ABIEncoderV2;
+			contract A {
+				struct S { uint a; bytes b; uint[] c; }
+				function f(S memory s, uint[2][] memory t) public pure returns (S memory, uint) { return (s, t.length); }
+				function g(uint x, uint y) public pure returns (uint) { return x + y * 7; }
+			}
+		)"},
+		{"b.sol", R"(
+			pragma experimental ABIEncoderV2;
+			import "a.sol";
+			contract B {
+				mapping(uint => uint) m;
+				function f(A.S[] memory s, string memory t) public returns (bytes memory, string memory) {
+					m[s.length] = s[0].a - 1;
+					return (abi.encode(s), t);
+				}
+				function h(uint x, uint y) public pure returns (uint) { return x + y * 7; }
+				function create() public returns (A) { return new A(); }
+			}
+		)"},
+		{"c.sol", R"(
+			contract C {
+				uint x;
+				mapping(uint => uint) m;
+				function f(uint a, uint b) public returns (uint) { x = a + b; m[a] = b * 2; return x - 1; }
+				function g(uint a) public view returns (uint) { return m[a] / 3; }
+			}
+		)"},
+		{"d.sol", R"(
+			contract D {
+				mapping(uint => uint) m;
+				function f(uint a, uint b) public returns (uint) { m[b] = a * b; return a + b - 2; }
+			}
+		)"}
+	};
+
+	auto compile = [&](bool _shareYulFunctions, bool _ir) {
+		CompilerStack compiler;
+		compiler.setSources(sources);
+		compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		compiler.setOptimiserSettings(solidity::test::CommonOptions::get().optimize);
+		compiler.enableYulFunctionSharing(_shareYulFunctions);
+		if (_ir)
+		{
+			// The IR generator does not support the other contracts yet.
+			compiler.setRequestedContractNames({{"c.sol", {"C"}}, {"d.sol", {"D"}}});
+			compiler.enableIRGeneration();
+		}
+		BOOST_REQUIRE(compiler.compile());
+		map<string, string> outputs;
+		for (string const& contract: compiler.contractNames())
+			if (_ir)
+				outputs[contract] = compiler.yulIR(contract) + compiler.yulIROptimized(contract);
+			else
+				outputs[contract] =
+					toHex(compiler.object(contract).bytecode) +
+					toHex(compiler.runtimeObject(contract).bytecode) +
+					compiler.assemblyString(contract);
+		return outputs;
+	};
+
+	for (bool ir: {false, true})
+	{
+		map<string, string> shared = compile(true, ir);
+		map<string, string> separate = compile(false, ir);
+		BOOST_REQUIRE_EQUAL(shared.size(), separate.size());
+		for (auto const& [contract, output]: shared)
+		{
+			BOOST_CHECK(!output.empty());
+			BOOST_CHECK_MESSAGE(output == separate.at(contract), "Output of " + contract + " differs.");
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(yul_strings_outlive_reset)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint x;
+			function f(uint a) public returns (uint) { x = a * 7; return x + 1; }
+		}
+	)";
+	auto compile = [&](CompilerStack& _compiler) {
+		_compiler.setSources({{"", sourceCode}});
+		_compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		_compiler.setOptimiserSettings(solidity::test::CommonOptions::get().optimize);
+		_compiler.enableIRGeneration();
+		BOOST_REQUIRE(_compiler.compile());
+	};
+
+	CompilerStack compiler;
+	compile(compiler);
+	// The optimized IR is kept as a Yul object and only printed on request, so a reset
+	// must not invalidate its strings while the compiler stack exists.
+	yul::YulStringRepository::reset();
+	string const optimizedIR = compiler.yulIROptimized("C");
+
+	CompilerStack reference;
+	compile(reference);
+	BOOST_CHECK(!optimizedIR.empty());
+	BOOST_CHECK_EQUAL(optimizedIR, reference.yulIROptimized("C"));
+}
+
+BOOST_AUTO_TEST_CASE(inline_assembly_cache)
+{
+	// Counts the snippets that had to be parsed, analysed and optimised.
+	auto misses = [](CompilerContext& _context, OptimiserSettings const& _settings) {
+		Profiler profiler;
+		{
+			Profiler::Scope scope{&profiler};
+			_context.appendInlineAssembly(
+				"{ function f(a) -> b { b := mul(a, 0x1a2b3c4d) } sstore(0, f(calldataload(0))) }",
+				{},
+				{},
+				false,
+				_settings
+			);
+		}
+		auto entries = profiler.entries();
+		return entries.count("codegen.inlineAssembly") ? entries.at("codegen.inlineAssembly").calls : 0;
+	};
+
+	langutil::EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	OptimiserSettings settings = OptimiserSettings::full();
+	CompilerContext runtimeContext(evmVersion, RevertStrings::Default);
+	CompilerContext creationContext(evmVersion, RevertStrings::Default, &runtimeContext);
+	CompilerContext otherContext(evmVersion, RevertStrings::Default);
+
+	BOOST_CHECK_EQUAL(misses(runtimeContext, settings), 1);
+	BOOST_CHECK_EQUAL(misses(runtimeContext, settings), 0);
+	// The cache is shared between contexts and compilations.
+	BOOST_CHECK_EQUAL(misses(otherContext, settings), 0);
+	// Creation code is optimised differently.
+	BOOST_CHECK_EQUAL(misses(creationContext, settings), 1);
+	BOOST_CHECK_EQUAL(misses(creationContext, settings), 0);
+	// So is code optimised with different settings.
+	settings.expectedExecutionsPerDeployment = 1;
+	BOOST_CHECK_EQUAL(misses(runtimeContext, settings), 1);
+	BOOST_CHECK_EQUAL(misses(runtimeContext, OptimiserSettings::minimal()), 1);
+	BOOST_CHECK_EQUAL(misses(runtimeContext, OptimiserSettings::minimal()), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
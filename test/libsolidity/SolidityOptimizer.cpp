@@ -56,6 +56,7 @@ public:
 		// "minimal" / "standard".
 		m_optimiserSettings = _optimize ? OptimiserSettings::full() : OptimiserSettings::none();
 		m_optimiserSettings.expectedExecutionsPerDeployment = _optimizeRuns;
+		m_optimiserSettings.runCSEAcrossBlocks = solidity::test::CommonOptions::get().optimizeCSEAcrossBlocks;
 		bytes const& ret = compileAndRun(_sourceCode, _value, _contractName);
 		m_optimiserSettings = std::move(previousSettings);
 		return ret;
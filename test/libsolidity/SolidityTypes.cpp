@@ -127,6 +127,36 @@ BOOST_AUTO_TEST_CASE(storage_layout_arrays)
 	BOOST_CHECK(ArrayType(DataLocation::Storage, TypeProvider::fixedBytes(32), 9).storageSize() == 9);
 }
 
+BOOST_AUTO_TEST_CASE(interned_types)
+{
+	TypeProvider provider;
+	TypeProvider::Scope scope{provider};
+
+	TypePointer uintArray = TypeProvider::array(DataLocation::Memory, TypeProvider::uint256());
+	BOOST_CHECK_EQUAL(uintArray, TypeProvider::array(DataLocation::Memory, TypeProvider::uint256()));
+	BOOST_CHECK(uintArray != TypeProvider::array(DataLocation::Storage, TypeProvider::uint256()));
+	BOOST_CHECK(uintArray != TypeProvider::array(DataLocation::Memory, TypeProvider::uint256(), 3));
+	BOOST_CHECK_EQUAL(
+		TypeProvider::mapping(TypeProvider::address(), uintArray),
+		TypeProvider::mapping(TypeProvider::address(), uintArray)
+	);
+	BOOST_CHECK_EQUAL(
+		TypeProvider::tuple({TypeProvider::boolean(), uintArray}),
+		TypeProvider::tuple({TypeProvider::boolean(), uintArray})
+	);
+	TypePointer bytesMemory = TypeProvider::bytesMemory();
+	BOOST_CHECK_EQUAL(TypeProvider::withLocation(TypeProvider::bytesStorage(), DataLocation::Memory, true), bytesMemory);
+
+	// Rational numbers are not fully described by their identifier.
+	TypePointer one = TypeProvider::rationalNumber(1);
+	BOOST_CHECK(TypeProvider::tuple({one}) != TypeProvider::tuple({one}));
+
+	TypeProvider otherProvider;
+	TypeProvider::Scope otherScope{otherProvider};
+	BOOST_CHECK(uintArray != TypeProvider::array(DataLocation::Memory, TypeProvider::uint256()));
+	BOOST_CHECK(TypeProvider::uint256() != dynamic_cast<ArrayType const&>(*uintArray).baseType());
+}
+
 BOOST_AUTO_TEST_CASE(type_identifier_escaping)
 {
 	BOOST_CHECK_EQUAL(Type::escapeIdentifier("("), "$_");
@@ -20,9 +20,11 @@
  */
 
 #include <string>
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
+#include <libyul/YulString.h>
 #include <libsolutil/JSON.h>
 #include <test/Metadata.h>
 
@@ -1363,6 +1365,390 @@ BOOST_AUTO_TEST_CASE(standard_output_selection_wildcard_multiple_sources)
 	BOOST_REQUIRE(result["sources"]["B"].isObject());
 }
 
+BOOST_AUTO_TEST_CASE(parallelism_invalid)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"parallelism": 0
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be a positive integer."));
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_same_output)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": { "*": [ "evm.bytecode.object", "evm.deployedBytecode.object", "evm.legacyAssembly", "metadata" ] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { uint x; function f() public { x = 7; } }"
+			},
+			"fileB": {
+				"content": "import \"fileA\"; contract B { function f() public returns (A) { return new A(); } }"
+			},
+			"fileC": {
+				"content": "import \"fileA\"; contract C { function f() public returns (A) { return new A(); } }"
+			},
+			"fileD": {
+				"content": "import \"fileB\"; contract D { function f() public returns (B) { return new B(); } }"
+			},
+			"fileE": {
+				"content": "contract E { function f(uint a) public pure returns (uint) { return a * 0x1234567890abcdef; } }"
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value sequentialResult = compiler.compile(parsedInput);
+	BOOST_REQUIRE(containsAtMostWarnings(sequentialResult));
+
+	parsedInput["settings"]["parallelism"] = 4;
+	Json::Value parallelResult = compiler.compile(parsedInput);
+	BOOST_REQUIRE(containsAtMostWarnings(parallelResult));
+
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(sequentialResult), util::jsonCompactPrint(parallelResult));
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_sub_assemblies)
+{
+	// The creation and runtime code of F share the creation code of A as a sub-assembly.
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"fileF": { "F": [ "evm.bytecode.object", "evm.deployedBytecode.object", "evm.legacyAssembly" ] }
+			}
+		},
+		"sources": {
+			"fileF": {
+				"content": "contract A { uint x; function f() public { x = 7; } } contract B { function g(uint a) public pure returns (uint) { return a * 0x1234; } } contract C { bytes32 h = keccak256(\"c\"); } contract F { A a = new A(); function f() public returns (A, B, C) { return (new A(), new B(), new C()); } }"
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value sequentialResult = compiler.compile(parsedInput);
+	BOOST_REQUIRE(containsAtMostWarnings(sequentialResult));
+
+	parsedInput["settings"]["parallelism"] = 4;
+	Json::Value parallelResult = compiler.compile(parsedInput);
+	BOOST_REQUIRE(containsAtMostWarnings(parallelResult));
+
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(sequentialResult), util::jsonCompactPrint(parallelResult));
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_same_ast)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"*": { "": [ "ast" ], "*": [ "evm.bytecode.object" ] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "import \"fileC\"; contract A is C { function f() public view returns (address) { return address(this); } }"
+			},
+			"fileB": {
+				"content": "import \"fileA\"; contract B { function g() public pure returns (uint r) { assembly { r := add(1, 2) } } }"
+			},
+			"fileC": {
+				"content": "import \"fileD\"; contract C { D d; uint[] x; function h() public { x.push(uint8(1)); } }"
+			},
+			"fileD": {
+				"content": "contract D { struct S { uint a; } mapping(uint => S) m; }"
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value sequentialResult = compiler.compile(parsedInput);
+	BOOST_REQUIRE(containsAtMostWarnings(sequentialResult));
+
+	parsedInput["settings"]["parallelism"] = 3;
+	Json::Value parallelResult = compiler.compile(parsedInput);
+	BOOST_REQUIRE(containsAtMostWarnings(parallelResult));
+
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(sequentialResult), util::jsonCompactPrint(parallelResult));
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_same_errors)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"fileA": {
+				"content": "import \"missing1\"; contract A { function f() public {} }"
+			},
+			"fileB": {
+				"content": "import \"fileA\"; contract B { function g( public {} }"
+			},
+			"fileC": {
+				"content": "import \"missing2\"; contract C { function h() public { uint x = ; } }"
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value sequentialResult = compiler.compile(parsedInput);
+	BOOST_REQUIRE(sequentialResult["errors"].size() >= 3);
+
+	parsedInput["settings"]["parallelism"] = 2;
+	Json::Value parallelResult = compiler.compile(parsedInput);
+
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(sequentialResult), util::jsonCompactPrint(parallelResult));
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_error_limits)
+{
+	// Every source alone has less errors than are reported at most, but not all of them together.
+	Json::Value input;
+	input["language"] = "Solidity";
+	input["settings"]["parserErrorRecovery"] = true;
+	for (size_t source = 0; source < 3; ++source)
+	{
+		string content;
+		for (size_t contract = 0; contract < 100; ++contract)
+			content += "contract C" + to_string(source) + "_" + to_string(contract) + " { function f() public { uint x = ; } }\n";
+		input["sources"]["file" + to_string(source)]["content"] = content;
+	}
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value sequentialResult = compiler.compile(input);
+	BOOST_REQUIRE(containsError(sequentialResult, "Warning", "There are more than 256 errors. Aborting."));
+
+	input["settings"]["parallelism"] = 3;
+	Json::Value parallelResult = compiler.compile(input);
+
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(sequentialResult), util::jsonCompactPrint(parallelResult));
+}
+
+BOOST_AUTO_TEST_CASE(profiling)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true, "details": { "yul": true } },
+			"profiling": true,
+			"outputSelection": {
+				"fileA": { "A": [ "evm.bytecode.object" ] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x) public pure returns (uint) { assembly { x := add(x, 1) } return x; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_REQUIRE(result["profiling"].isObject());
+	for (string phase: {"parsing", "analysis.typeChecking", "codegen", "evmasm.optimiser", "yul.analysis"})
+	{
+		BOOST_REQUIRE_MESSAGE(result["profiling"].isMember(phase), phase);
+		BOOST_CHECK(result["profiling"][phase]["calls"].asUInt() >= 1);
+		BOOST_CHECK(result["profiling"][phase]["microseconds"].isInt64());
+	}
+
+	Json::Value settings = Json::objectValue;
+	settings["profiling"] = "yes";
+	Json::Value invalidInput = Json::objectValue;
+	invalidInput["language"] = "Solidity";
+	invalidInput["settings"] = settings;
+	invalidInput["sources"]["fileA"]["content"] = "contract A { }";
+	result = compile(util::jsonCompactPrint(invalidInput));
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.profiling\" must be a Boolean."));
+}
+
+BOOST_AUTO_TEST_CASE(artifact_cache)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"*": { "*": [ "abi", "evm.bytecode.object" ] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "import \"lib\"; contract A is L { }"
+			}
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	boost::filesystem::path cacheDirectory =
+		boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-cache-test-%%%%-%%%%");
+	string library = "contract L { function f() public {} }";
+	size_t reads = 0;
+	ReadCallback::Callback readFile = [&](string const&, string const& _path)
+	{
+		++reads;
+		if (_path == "lib")
+			return ReadCallback::Result{true, library};
+		return ReadCallback::Result{false, "Not found."};
+	};
+	auto countEntries = [&]() {
+		return size_t(distance(
+			boost::filesystem::directory_iterator(cacheDirectory),
+			boost::filesystem::directory_iterator()
+		));
+	};
+
+	solidity::frontend::StandardCompiler uncachedCompiler(readFile);
+	Json::Value expectation = uncachedCompiler.compile(parsedInput);
+	BOOST_REQUIRE(containsAtMostWarnings(expectation));
+
+	solidity::frontend::StandardCompiler compiler(readFile, make_shared<ArtifactCache>(cacheDirectory));
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(compiler.compile(parsedInput)), util::jsonCompactPrint(expectation));
+	BOOST_CHECK_EQUAL(countEntries(), 1);
+
+	// A cache hit only reads the imported file to validate the entry.
+	reads = 0;
+	parsedInput["settings"]["parallelism"] = 2;
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(compiler.compile(parsedInput)), util::jsonCompactPrint(expectation));
+	BOOST_CHECK_EQUAL(reads, 1);
+	BOOST_CHECK_EQUAL(countEntries(), 1);
+
+	// Changing the imported file invalidates the entry.
+	library = "contract L { function g() public {} }";
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["fileA"]["A"]["abi"][0]["name"] == "g");
+
+	// Changing the settings leads to a new entry.
+	parsedInput["settings"]["optimizer"]["enabled"] = true;
+	BOOST_REQUIRE(containsAtMostWarnings(compiler.compile(parsedInput)));
+	BOOST_CHECK_EQUAL(countEntries(), 2);
+
+	boost::filesystem::remove_all(cacheDirectory);
+}
+
+BOOST_AUTO_TEST_CASE(yul_strings_kept_across_compilations)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true, "details": { "yul": true } },
+			"outputSelection": {
+				"fileA": { "A": [ "evm.bytecode.object" ] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x) public pure returns (uint) { assembly { x := add(x, 1) } return x; } }"
+			}
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+	yul::YulStringRepository& repository = yul::YulStringRepository::instance();
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value expectation = compiler.compile(parsedInput);
+	BOOST_REQUIRE(containsAtMostWarnings(expectation));
+
+	// The second compilation finds all its strings in the repository and a string
+	// added in between remains valid.
+	yul::YulString marker("yul_strings_kept_across_compilations");
+	size_t const size = repository.size();
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(compiler.compile(parsedInput)), util::jsonCompactPrint(expectation));
+	BOOST_CHECK_EQUAL(repository.size(), size);
+	BOOST_CHECK_EQUAL(marker.str(), "yul_strings_kept_across_compilations");
+
+	// Beyond the limit, the repository is reset before the next compilation.
+	for (size_t i = repository.size(); i <= solidity::frontend::StandardCompiler::MaxYulStrings; ++i)
+		yul::YulString("yul_strings_kept_across_compilations_" + to_string(i));
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(compiler.compile(parsedInput)), util::jsonCompactPrint(expectation));
+	BOOST_CHECK(repository.size() <= size);
+}
+
+BOOST_AUTO_TEST_CASE(inline_assembly_cache_across_compilations)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true, "runs": 1234, "details": { "yul": true } },
+			"profiling": true,
+			"outputSelection": {
+				"fileA": { "A": [ "evm.bytecode.object" ] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "pragma experimental ABIEncoderV2; contract A { function f(uint[] memory x, string memory y) public pure returns (uint, string memory) { return (x.length * 0x3c4d5e6f, y); } }"
+			}
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+	auto misses = [](Json::Value const& _result) {
+		BOOST_REQUIRE(containsAtMostWarnings(_result));
+		return _result["profiling"]["codegen.inlineAssembly"]["calls"].asUInt();
+	};
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_CHECK(misses(result) > 0);
+	string const bytecode = result["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].asString();
+
+	// All snippets are found in the cache of the first compilation.
+	result = compiler.compile(parsedInput);
+	BOOST_CHECK_EQUAL(misses(result), 0);
+	BOOST_CHECK_EQUAL(result["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].asString(), bytecode);
+
+	// The snippets are optimised for a different number of runs.
+	parsedInput["settings"]["optimizer"]["runs"] = 4321;
+	BOOST_CHECK(misses(compiler.compile(parsedInput)) > 0);
+	BOOST_CHECK_EQUAL(misses(compiler.compile(parsedInput)), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
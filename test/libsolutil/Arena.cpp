@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for Arena and ArenaAllocator.
+ */
+
+#include <libsolutil/Arena.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ArenaTest)
+
+BOOST_AUTO_TEST_CASE(alignment)
+{
+	Arena arena;
+	for (size_t alignment: {1, 2, 8, 16, 64})
+		for (size_t size: {1, 3, 17})
+		{
+			void* pointer = arena.allocate(size, alignment);
+			BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(pointer) % alignment, 0);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(large_allocations)
+{
+	Arena arena;
+	char* small = static_cast<char*>(arena.allocate(8, 8));
+	char* large = static_cast<char*>(arena.allocate(10 * 1024 * 1024, 8));
+	large[10 * 1024 * 1024 - 1] = 'x';
+	small[7] = 'y';
+	BOOST_CHECK(arena.reservedBytes() >= 10 * 1024 * 1024);
+	BOOST_CHECK_EQUAL(large[10 * 1024 * 1024 - 1], 'x');
+}
+
+BOOST_AUTO_TEST_CASE(objects_keep_arena_alive)
+{
+	shared_ptr<string> value;
+	weak_ptr<Arena> weakArena;
+	{
+		auto arena = make_shared<Arena>();
+		weakArena = arena;
+		value = allocate_shared<string>(ArenaAllocator<string>(arena), 100, 'a');
+		auto other = allocate_shared<string>(ArenaAllocator<string>(arena), "b");
+	}
+	BOOST_CHECK(!weakArena.expired());
+	BOOST_CHECK_EQUAL(*value, string(100, 'a'));
+	value.reset();
+	BOOST_CHECK(weakArena.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
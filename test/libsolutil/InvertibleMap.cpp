@@ -0,0 +1,138 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the snapshots of InvertibleMap.
+ */
+
+#include <libsolutil/InvertibleMap.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+using Map = InvertibleMap<int, int>;
+
+/// Reference implementation of the join based on a full copy of the older state.
+void joinWithCopy(Map& _this, Map const& _older)
+{
+	set<int> keysToErase;
+	for (auto const& item: _this.values)
+	{
+		auto it = _older.values.find(item.first);
+		if (it == _older.values.end() || it->second != item.second)
+			keysToErase.insert(item.first);
+	}
+	for (int key: keysToErase)
+		_this.eraseKey(key);
+}
+
+void randomModification(mt19937& _random, Map& _a, Map& _b)
+{
+	int key = static_cast<int>(_random() % 8);
+	int value = static_cast<int>(_random() % 4);
+	switch (_random() % 10)
+	{
+	case 0:
+		_a.eraseKey(key);
+		_b.eraseKey(key);
+		break;
+	case 1:
+		_a.eraseValue(value);
+		_b.eraseValue(value);
+		break;
+	case 2:
+		_a.clear();
+		_b.clear();
+		break;
+	default:
+		_a.set(key, value);
+		_b.set(key, value);
+	}
+}
+
+void checkConsistent(Map const& _map)
+{
+	for (auto const& [key, value]: _map.values)
+		BOOST_CHECK(_map.references.at(value).count(key));
+	for (auto const& [value, keys]: _map.references)
+		for (int key: keys)
+			BOOST_CHECK(_map.values.at(key) == value);
+}
+
+/// Applies random modifications in nested branches to both maps, joining one of them
+/// with snapshots and the other with copies.
+void randomBranches(mt19937& _random, Map& _snapshots, Map& _copies, size_t _depth)
+{
+	for (size_t i = 0; i < 6; ++i)
+		if (_depth < 4 && _random() % 3 == 0)
+		{
+			size_t snapshot = _snapshots.snapshot();
+			Map older = _copies;
+			randomBranches(_random, _snapshots, _copies, _depth + 1);
+			_snapshots.joinWithSnapshot(snapshot);
+			joinWithCopy(_copies, older);
+			BOOST_REQUIRE(_snapshots.values == _copies.values);
+		}
+		else
+			randomModification(_random, _snapshots, _copies);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(InvertibleMapTest)
+
+BOOST_AUTO_TEST_CASE(join_with_snapshot)
+{
+	Map knowledge;
+	knowledge.set(1, 10);
+	knowledge.set(2, 20);
+	knowledge.set(3, 30);
+	size_t snapshot = knowledge.snapshot();
+	knowledge.set(1, 11);
+	knowledge.eraseKey(2);
+	knowledge.set(2, 20);
+	knowledge.eraseValue(30);
+	knowledge.set(4, 40);
+	knowledge.joinWithSnapshot(snapshot);
+	BOOST_CHECK((knowledge.values == map<int, int>{{2, 20}}));
+	checkConsistent(knowledge);
+}
+
+BOOST_AUTO_TEST_CASE(same_as_join_with_copy)
+{
+	mt19937 random(42);
+	for (size_t run = 0; run < 200; ++run)
+	{
+		Map snapshots;
+		Map copies;
+		randomBranches(random, snapshots, copies, 0);
+		BOOST_CHECK(snapshots.values == copies.values);
+		checkConsistent(snapshots);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -194,6 +194,21 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(unclosed_tags_rendered)
+{
+	string templ = "<#b>x<?c>y</d> <!c>";
+	Whiskers m(templ);
+	BOOST_CHECK_EQUAL(m("c", true).render(), templ);
+}
+
+BOOST_AUTO_TEST_CASE(template_reused)
+{
+	string templ = "<?c><a><!c>-</c>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "A")("c", true).render(), "A");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "B")("c", true).render(), "B");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "B")("c", false).render(), "-");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,119 @@
+/*
+    This file is part of solidity.
+
+    solidity is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    solidity is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <test/Common.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/YulString.h>
+#include <libyul/AsmData.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/backends/evm/ConstantOptimiser.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+
+#include <libsolutil/Profiler.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringRepositoryTest)
+
+BOOST_AUTO_TEST_CASE(empty_string)
+{
+	BOOST_CHECK(YulString().empty());
+	BOOST_CHECK(YulString("") == YulString());
+	BOOST_CHECK_EQUAL(YulString("").str(), "");
+	BOOST_CHECK(!YulString("x").empty());
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	YulStringRepository::Scope scope;
+	size_t const threadCount = 4;
+	size_t const stringCount = 5000;
+	vector<vector<YulString>> strings(threadCount);
+	vector<thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t]() {
+			// Every thread inserts the strings in a different order.
+			for (size_t i = 0; i < stringCount; ++i)
+				strings[t].emplace_back("concurrent_" + to_string((i * (t + 1) * 7919) % stringCount));
+		});
+	for (auto& thread: threads)
+		thread.join();
+
+	map<string, YulString> expectation;
+	for (size_t t = 0; t < threadCount; ++t)
+		for (YulString const& s: strings[t])
+		{
+			BOOST_REQUIRE_EQUAL(s.str().substr(0, 11), "concurrent_");
+			auto it = expectation.emplace(s.str(), s).first;
+			BOOST_CHECK(it->second == s);
+			BOOST_CHECK(YulString(s.str()) == s);
+		}
+	BOOST_CHECK_EQUAL(expectation.size(), stringCount);
+}
+
+BOOST_AUTO_TEST_CASE(reset_deferred_while_scope_active)
+{
+	YulStringRepository::Scope scope;
+	YulString s("still_valid_after_reset");
+	YulStringRepository::reset();
+	BOOST_CHECK_EQUAL(s.str(), "still_valid_after_reset");
+	BOOST_CHECK(YulString("still_valid_after_reset") == s);
+}
+
+BOOST_AUTO_TEST_CASE(constant_optimiser_memo_outlives_reset)
+{
+	// Returns the optimised code and the number of constants whose representation was searched.
+	auto optimise = []() {
+		EVMDialect const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+		shared_ptr<Block> ast = parse(
+			"{ sstore(0x10000000000000000000000000000000000000000000, 0x10000000000000000000000000000000000000000000) }",
+			false
+		).first;
+		BOOST_REQUIRE(ast);
+		util::Profiler profiler;
+		{
+			util::Profiler::Scope scope{&profiler};
+			GasMeter meter(dialect, false, 200);
+			ConstantOptimiser{dialect, meter}(*ast);
+		}
+		auto entries = profiler.entries();
+		size_t searches = entries.count("yul.constantOptimiser") ? entries.at("yul.constantOptimiser").calls : 0;
+		return make_pair(AsmPrinter{}(*ast), searches);
+	};
+
+	auto [code, searches] = optimise();
+	BOOST_CHECK(code.find("0x1000") == string::npos);
+	BOOST_CHECK_EQUAL(searches, 1);
+	YulStringRepository::reset();
+	BOOST_CHECK(optimise() == make_pair(code, size_t(0)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
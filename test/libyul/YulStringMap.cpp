@@ -0,0 +1,109 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for YulStringMap and YulStringSet.
+ */
+
+#include <libyul/YulStringMap.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <random>
+#include <set>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringMapTest)
+
+BOOST_AUTO_TEST_CASE(basic)
+{
+	YulStringMap<size_t> map;
+	BOOST_CHECK(map.empty());
+	BOOST_CHECK_EQUAL(map.count(YulString("a")), 0);
+	BOOST_CHECK(map.find(YulString("a")) == map.end());
+	BOOST_CHECK_THROW(map.at(YulString("a")), std::out_of_range);
+
+	map[YulString("a")] = 1;
+	++map[YulString()];
+	BOOST_CHECK(!map.emplace(YulString("a"), 7).second);
+	BOOST_CHECK(map.emplace(YulString("b"), 2).second);
+	BOOST_CHECK_EQUAL(map.size(), 3);
+	BOOST_CHECK_EQUAL(map.at(YulString("a")), 1);
+	BOOST_CHECK_EQUAL(map.at(YulString()), 1);
+	BOOST_CHECK_EQUAL(map.find(YulString("b"))->second, 2);
+
+	BOOST_CHECK_EQUAL(map.erase(YulString("a")), 1);
+	BOOST_CHECK_EQUAL(map.erase(YulString("a")), 0);
+	BOOST_CHECK_EQUAL(map.count(YulString("a")), 0);
+	BOOST_CHECK_EQUAL(map.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(same_as_std_map)
+{
+	mt19937 random(1);
+	vector<YulString> keys;
+	for (size_t i = 0; i < 300; ++i)
+		keys.emplace_back("map_test_" + to_string(i));
+
+	YulStringMap<size_t> map;
+	std::map<YulString, size_t> expectation;
+	for (size_t i = 0; i < 20000; ++i)
+	{
+		YulString key = keys[random() % keys.size()];
+		switch (random() % 3)
+		{
+		case 0:
+			map[key] += i;
+			expectation[key] += i;
+			break;
+		case 1:
+			BOOST_REQUIRE_EQUAL(map.erase(key), expectation.erase(key));
+			break;
+		default:
+			BOOST_REQUIRE_EQUAL(map.count(key), expectation.count(key));
+			if (expectation.count(key))
+				BOOST_REQUIRE_EQUAL(map.at(key), expectation.at(key));
+		}
+		BOOST_REQUIRE_EQUAL(map.size(), expectation.size());
+	}
+
+	std::map<YulString, size_t> elements;
+	for (auto const& [key, value]: map)
+		BOOST_REQUIRE(elements.emplace(key, value).second);
+	BOOST_CHECK(elements == expectation);
+}
+
+BOOST_AUTO_TEST_CASE(set)
+{
+	YulStringSet set{std::set<YulString>{YulString("x"), YulString("y")}};
+	BOOST_CHECK(!set.insert(YulString("x")));
+	BOOST_CHECK(set.insert(YulString("z")));
+	BOOST_CHECK_EQUAL(set.size(), 3);
+	BOOST_CHECK_EQUAL(set.erase(YulString("y")), 1);
+	BOOST_CHECK_EQUAL(set.count(YulString("y")), 0);
+	BOOST_CHECK_EQUAL(set.count(YulString("z")), 1);
+	std::set<YulString> elements(set.begin(), set.end());
+	BOOST_CHECK(elements == (std::set<YulString>{YulString("x"), YulString("z")}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
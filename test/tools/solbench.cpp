@@ -0,0 +1,405 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Compiler throughput benchmark.
+ * Compiles a corpus of projects in several modes and reports the median wall-clock time,
+ * the peak resident set size and the size of the output as JSON.
+ * On Unix systems, every input and mode is compiled in its own process.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/interface/Version.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+struct Input
+{
+	string name;
+	StringMap sources;
+};
+
+struct Mode
+{
+	string name;
+	/// Configures the compiler and runs the measured phases.
+	/// @returns false if the compilation failed.
+	function<bool(CompilerStack&)> run;
+	/// True if the mode produces bytecode.
+	bool producesBytecode;
+};
+
+/// Reads all Solidity files below @a _directory, named by their path relative to it.
+StringMap readSources(fs::path const& _directory)
+{
+	StringMap sources;
+	for (fs::recursive_directory_iterator it(_directory), end; it != end; ++it)
+		if (fs::is_regular_file(it->path()) && it->path().extension() == ".sol")
+			sources[fs::relative(it->path(), _directory).generic_string()] = readFileAsString(it->path().string());
+	return sources;
+}
+
+/// Every subdirectory of @a _directory that contains Solidity files is one input.
+/// Solidity files directly inside @a _directory form another one.
+vector<Input> readCorpus(fs::path const& _directory)
+{
+	vector<Input> inputs;
+	StringMap topLevelSources;
+	vector<fs::path> entries{fs::directory_iterator(_directory), fs::directory_iterator()};
+	sort(entries.begin(), entries.end());
+	for (fs::path const& entry: entries)
+		if (fs::is_directory(entry))
+		{
+			StringMap sources = readSources(entry);
+			if (!sources.empty())
+				inputs.push_back({entry.filename().string(), move(sources)});
+		}
+		else if (entry.extension() == ".sol")
+			topLevelSources[entry.filename().string()] = readFileAsString(entry.string());
+	if (!topLevelSources.empty())
+		inputs.push_back({_directory.filename().string(), move(topLevelSources)});
+	return inputs;
+}
+
+/// @returns a single source with @a _contracts contracts of @a _functions functions each,
+/// which use storage, loops, events, internal calls and external calls.
+Input generateInput(size_t _contracts, size_t _functions)
+{
+	string source = "pragma solidity >=0.6.0;\n";
+	for (size_t c = 0; c < _contracts; ++c)
+	{
+		string const name = "G" + to_string(c);
+		source += "contract " + name + (c > 0 ? " is G" + to_string(c - 1) : "") + " {\n";
+		source += "\tmapping(uint => uint) m" + to_string(c) + ";\n";
+		source += "\tuint[] a" + to_string(c) + ";\n";
+		source += "\tevent E" + to_string(c) + "(uint indexed x, uint y);\n";
+		for (size_t f = 0; f < _functions; ++f)
+		{
+			string const suffix = to_string(c) + "_" + to_string(f);
+			source +=
+				"\tfunction f" + suffix + "(uint x, bytes memory data) public returns (uint r) {\n"
+				"\t\tr = x * " + to_string(f + 3) + " + data.length;\n"
+				"\t\tfor (uint i = 0; i < r % 11; i++) {\n"
+				"\t\t\tm" + to_string(c) + "[i] += r ^ i;\n"
+				"\t\t\tif (i % 3 == 0) a" + to_string(c) + ".push(keccak256(abi.encodePacked(i, r)).length);\n"
+				"\t\t}\n"
+				"\t\tr = g" + suffix + "(r, x);\n"
+				"\t\temit E" + to_string(c) + "(x, r);\n"
+				"\t}\n"
+				"\tfunction g" + suffix + "(uint x, uint y) internal pure returns (uint) {\n"
+				"\t\treturn x > y ? x - y : (y - x) / (x | 1);\n"
+				"\t}\n";
+		}
+		source += "}\n";
+	}
+	source += "contract Factory {\n\tfunction create() public returns (address) {\n";
+	source += "\t\treturn address(new G" + to_string(_contracts - 1) + "());\n\t}\n}\n";
+	return {"generated", {{"generated.sol", source}}};
+}
+
+vector<Mode> modes()
+{
+	auto compile = [](OptimiserSettings _settings, bool _ir) {
+		return [=](CompilerStack& _compiler) {
+			_compiler.setOptimiserSettings(_settings);
+			_compiler.enableIRGeneration(_ir);
+			// The IR modes measure the IR generation alone.
+			_compiler.enableEvmBytecodeGeneration(!_ir);
+			return _compiler.compile();
+		};
+	};
+	OptimiserSettings legacyOptimizer = OptimiserSettings::standard();
+	legacyOptimizer.runYulOptimiser = false;
+	legacyOptimizer.optimizeStackAllocation = false;
+	return {
+		{"parsing", [](CompilerStack& _compiler) { return _compiler.parse(); }, false},
+		{"analysis", [](CompilerStack& _compiler) { return _compiler.parseAndAnalyze(); }, false},
+		{"evm", compile(OptimiserSettings::minimal(), false), true},
+		{"evm-optimized", compile(legacyOptimizer, false), true},
+		{"evm-optimized-yul", compile(OptimiserSettings::standard(), false), true},
+		{"ir", compile(OptimiserSettings::minimal(), true), false},
+		{"ir-optimized", compile(OptimiserSettings::standard(), true), false},
+	};
+}
+
+/// Compiles @a _input in @a _mode @a _repetitions times.
+/// @returns the measurements as JSON.
+Json::Value benchmark(Input const& _input, Mode const& _mode, size_t _repetitions)
+{
+	Json::Value result = Json::objectValue;
+	result["input"] = _input.name;
+	result["mode"] = _mode.name;
+
+	vector<double> times;
+	for (size_t i = 0; i < _repetitions; ++i)
+	{
+		CompilerStack compiler;
+		compiler.setSources(_input.sources);
+		auto start = chrono::steady_clock::now();
+		bool success = false;
+		try
+		{
+			success = _mode.run(compiler);
+		}
+		catch (UnimplementedFeatureError const& _error)
+		{
+			result["error"] = "Unimplemented feature: " + boost::diagnostic_information(_error);
+			return result;
+		}
+		times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+		if (!success)
+		{
+			result["error"] = "Compilation failed.";
+			for (auto const& error: compiler.errors())
+				if (error->type() != Error::Type::Warning)
+				{
+					string const* message = boost::get_error_info<errinfo_comment>(*error);
+					result["error"] = error->typeName() + (message ? ": " + *message : "");
+					break;
+				}
+			return result;
+		}
+
+		// The parsing and analysis modes do not produce any output.
+		if (i == 0 && compiler.state() >= CompilerStack::CompilationSuccessful)
+		{
+			size_t bytecodeSize = 0;
+			size_t irSize = 0;
+			for (string const& contract: compiler.contractNames())
+				if (_mode.producesBytecode)
+					bytecodeSize += compiler.object(contract).bytecode.size();
+				else
+					irSize += compiler.yulIROptimized(contract).size();
+			if (_mode.producesBytecode)
+				result["bytecodeSize"] = Json::UInt64(bytecodeSize);
+			else
+				result["irSize"] = Json::UInt64(irSize);
+		}
+	}
+
+	sort(times.begin(), times.end());
+	size_t const middle = times.size() / 2;
+	result["medianMilliseconds"] = times.size() % 2 ? times[middle] : (times[middle - 1] + times[middle]) / 2;
+	result["minMilliseconds"] = times.front();
+	result["maxMilliseconds"] = times.back();
+	return result;
+}
+
+/// Runs benchmark() in a child process, so that the peak resident set size of the child
+/// is the one of compiling @a _input in @a _mode and the caches of the compiler start empty.
+/// Without support for child processes, runs it in this process and does not report the
+/// peak resident set size.
+Json::Value benchmarkInChildProcess(Input const& _input, Mode const& _mode, size_t _repetitions)
+{
+#if defined(__unix__) || defined(__APPLE__)
+	Json::Value failure = Json::objectValue;
+	failure["input"] = _input.name;
+	failure["mode"] = _mode.name;
+	failure["error"] = "Could not run the benchmark process.";
+
+	int fds[2];
+	if (pipe(fds) != 0)
+		return failure;
+	pid_t const pid = fork();
+	if (pid < 0)
+	{
+		close(fds[0]);
+		close(fds[1]);
+		return failure;
+	}
+	if (pid == 0)
+	{
+		close(fds[0]);
+		string const output = jsonCompactPrint(benchmark(_input, _mode, _repetitions));
+		for (size_t written = 0; written < output.size();)
+		{
+			ssize_t const count = write(fds[1], output.data() + written, output.size() - written);
+			if (count <= 0)
+				_exit(1);
+			written += static_cast<size_t>(count);
+		}
+		_exit(0);
+	}
+
+	close(fds[1]);
+	string output;
+	char buffer[4096];
+	for (ssize_t count; (count = read(fds[0], buffer, sizeof(buffer))) > 0;)
+		output.append(buffer, static_cast<size_t>(count));
+	close(fds[0]);
+
+	int status = 0;
+	rusage usage;
+	Json::Value result;
+	if (
+		wait4(pid, &status, 0, &usage) != pid ||
+		!WIFEXITED(status) ||
+		WEXITSTATUS(status) != 0 ||
+		!jsonParseStrict(output, result)
+	)
+	{
+		failure["error"] = "The benchmark process failed.";
+		return failure;
+	}
+#if defined(__APPLE__)
+	result["peakRSSKilobytes"] = Json::UInt64(usage.ru_maxrss / 1024);
+#else
+	result["peakRSSKilobytes"] = Json::UInt64(usage.ru_maxrss);
+#endif
+	return result;
+#else
+	return benchmark(_input, _mode, _repetitions);
+#endif
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(solbench, compiler throughput benchmark.
+Usage: solbench [Options] <directory>...
+Compiles every project in the given directories, i.e. every subdirectory containing
+Solidity files, and a generated input in several modes. The median wall-clock time,
+the peak resident set size and the size of the output are written as JSON to standard
+output. Every input and mode is compiled in its own process, whose peak resident set
+size is reported. It is not reported on systems without child processes.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("repetitions", po::value<size_t>()->default_value(5), "Number of compilations per input and mode.")
+		("mode", po::value<vector<string>>()->composing(), "Only run the given mode. Can be given multiple times. "
+			"Modes: parsing, analysis, evm, evm-optimized, evm-optimized-yul, ir, ir-optimized.")
+		("input", po::value<vector<string>>()->composing(), "Only compile the input with the given name. Can be given multiple times.")
+		("generated-contracts", po::value<size_t>()->default_value(20), "Number of contracts of the generated input. Zero disables it.")
+		("generated-functions", po::value<size_t>()->default_value(20), "Number of functions per contract of the generated input.")
+		("input-dir", po::value<vector<string>>()->composing(), "Corpus directory.");
+	po::positional_options_description positionalOptions;
+	positionalOptions.add("input-dir", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(positionalOptions);
+		po::store(cmdLineParser.run(), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	size_t const repetitions = arguments["repetitions"].as<size_t>();
+	if (repetitions == 0)
+	{
+		cerr << "The number of repetitions has to be positive." << endl;
+		return 1;
+	}
+
+	vector<Input> inputs;
+	if (arguments.count("input-dir"))
+		for (string const& directory: arguments["input-dir"].as<vector<string>>())
+		{
+			if (!fs::is_directory(directory))
+			{
+				cerr << "Not a directory: " << directory << endl;
+				return 1;
+			}
+			inputs += readCorpus(directory);
+		}
+	if (size_t contracts = arguments["generated-contracts"].as<size_t>())
+		inputs.push_back(generateInput(contracts, arguments["generated-functions"].as<size_t>()));
+	if (arguments.count("input"))
+	{
+		vector<string> const names = arguments["input"].as<vector<string>>();
+		inputs.erase(remove_if(inputs.begin(), inputs.end(), [&](Input const& _input) {
+			return find(names.begin(), names.end(), _input.name) == names.end();
+		}), inputs.end());
+	}
+
+	vector<Mode> selectedModes = modes();
+	if (arguments.count("mode"))
+	{
+		vector<string> const names = arguments["mode"].as<vector<string>>();
+		for (string const& name: names)
+			if (none_of(selectedModes.begin(), selectedModes.end(), [&](Mode const& _mode) { return _mode.name == name; }))
+			{
+				cerr << "Unknown mode: " << name << endl;
+				return 1;
+			}
+		selectedModes.erase(remove_if(selectedModes.begin(), selectedModes.end(), [&](Mode const& _mode) {
+			return find(names.begin(), names.end(), _mode.name) == names.end();
+		}), selectedModes.end());
+	}
+
+	Json::Value output = Json::objectValue;
+	output["compilerVersion"] = VersionString;
+	output["repetitions"] = Json::UInt64(repetitions);
+	output["results"] = Json::arrayValue;
+	for (Input const& input: inputs)
+		for (Mode const& mode: selectedModes)
+		{
+			cerr << "Benchmarking " << input.name << " (" << mode.name << ")..." << endl;
+			output["results"].append(benchmarkInChildProcess(input, mode, repetitions));
+		}
+	cout << jsonPrettyPrint(output) << endl;
+	return 0;
+}